@@ -0,0 +1,154 @@
+/**
+ * @file AgentBench.cpp
+ * @brief Benchmarks of the agents: large populations, shared exploration and ratings.
+ */
+
+#include <algorithm> // std::max
+#include <iostream>  // std::cout
+#include <string>    // std::string, std::to_string
+#include <utility>   // std::pair
+#include <vector>    // std::vector
+
+#include "agent/Agent.h"            // Agent
+#include "agent/ExplorationCache.h" // ExplorationCache
+#include "agent/RatingStrategy.h"   // RatingStrategy
+#include "game/Game.h"              // Game
+#include "random/myRandom.h"        // myRandom::choice, myRandom::randInt
+
+#include "Bench.h"
+
+/**
+ * @brief Play complete games with many simulated agents sharing a map, and return the mean cost of a round of
+ * an agent.
+ *
+ * @param parallel If `true`, the agents of the game play each round in parallel on the OpenMP threads.
+ * @param shareExploration If `true`, the agents share the exploration distributions through an
+ *        `ExplorationCache`.
+ */
+double benchmarkPopulation(int numberOfGames, int numberOfPlayers, bool parallel, bool shareExploration = false)
+{
+    const int numberOfRounds{20};
+    const std::vector<RatingStrategy> &ratingStrategies{getBenchmarkRatings()};
+    Game game(numberOfRounds, numberOfPlayers);
+    ExplorationCache explorationCache(game);
+    std::vector<Agent> agents(numberOfPlayers, Agent(getBenchmarkOpenings(), ratingStrategies[0]));
+
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iGame{0}; iGame < numberOfGames; ++iGame)
+            {
+                game.reset();
+                for (int iPlayer{0}; iPlayer < numberOfPlayers; ++iPlayer)
+                {
+                    agents[iPlayer].assignToGame(game.getAddress(), ratingStrategies[iPlayer % 2],
+                                                 shareExploration ? &explorationCache : nullptr);
+                }
+                for (int iRound{0}; iRound < numberOfRounds; ++iRound)
+                {
+                    if (parallel)
+                    {
+                        Agent::playARoundInParallel(agents);
+                    }
+                    else
+                    {
+                        for (auto &agent : agents)
+                        {
+                            agent.playARound();
+                        }
+                    }
+                }
+            }
+        })};
+    return duration / (static_cast<double>(numberOfGames) * numberOfRounds * numberOfPlayers);
+}
+
+void benchmarkPopulations()
+{
+    std::cout << "Game + Agent with many players, 20 rounds x 3 turns x 225 cells\n";
+    for (const int numberOfPlayers : {5, 100, 1000, 10000})
+    {
+        // About as many rounds of agents are played for each population, with at least one game
+        const int numberOfGames{std::max(1, 10000 / numberOfPlayers)};
+        printResult(std::to_string(numberOfPlayers) + " players, serial",
+                    benchmarkPopulation(numberOfGames, numberOfPlayers, false), "agent round");
+        printResult(std::to_string(numberOfPlayers) + " players, parallel",
+                    benchmarkPopulation(numberOfGames, numberOfPlayers, true), "agent round");
+    }
+}
+
+void benchmarkExplorationSharing()
+{
+    std::cout << "Game + Agent with the exploration distributions shared by the agents, 20 rounds x 3 turns x 225 "
+                 "cells, one thread\n";
+    for (const int numberOfPlayers : {5, 100, 1000})
+    {
+        const int numberOfGames{std::max(1, 20000 / numberOfPlayers)};
+        printResult(std::to_string(numberOfPlayers) + " players, own distributions",
+                    benchmarkPopulation(numberOfGames, numberOfPlayers, false, false), "agent round");
+        printResult(std::to_string(numberOfPlayers) + " players, shared distributions",
+                    benchmarkPopulation(numberOfGames, numberOfPlayers, false, true), "agent round");
+    }
+}
+
+/**
+ * @brief Rate cells of random values, and return the mean cost of a rating.
+ *
+ * @param ratingStrategy The strategy giving the ratings.
+ * @param tabulated Whether the ratings are drawn from the table of the strategy, or from its probabilities
+ * computed for each rating as before the table.
+ */
+double benchmarkRating(const RatingStrategy &ratingStrategy, bool tabulated)
+{
+    std::vector<int> values(1000);
+    for (int &value : values)
+    {
+        value = myRandom::randInt(99);
+    }
+
+    const int numberOfRepetitions{tabulated ? 1000 : 100};
+    long long checksum{0};
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iRepetition{0}; iRepetition < numberOfRepetitions; ++iRepetition)
+            {
+                for (const int value : values)
+                {
+                    checksum += tabulated ? ratingStrategy.chooseRating(value)
+                                          : myRandom::choice(ratingStrategy.getRatings(),
+                                                             ratingStrategy.computeProbabilities(value));
+                }
+            }
+        })};
+
+    if (checksum == 0)
+    {
+        std::cout << "(checksum " << checksum << ")\n";
+    }
+    return duration / (numberOfRepetitions * static_cast<double>(values.size()));
+}
+
+void benchmarkRatings()
+{
+    std::cout << "Rating of a cell, probabilities computed per rating and tabulated\n";
+    const std::vector<std::pair<RatingStrategy, std::string>> ratingStrategies{
+        {getBenchmarkRatings()[0], "tanh"},
+        {RatingStrategy(std::vector<double>{0.3, 20., 4., 0.3, 40., 4., 0., 0.3, 60., 4., 0., 0.3, 80., 4., 0.3,
+                                            99., 4.},
+                        "gaussian"),
+         "gaussian"},
+        {RatingStrategy(std::vector<double>{0.5, 0.8}, "mns_linear"), "mns_linear"}};
+    for (const auto &[ratingStrategy, name] : ratingStrategies)
+    {
+        printResult(name + ", probabilities per rating", benchmarkRating(ratingStrategy, false), "rating");
+        printResult(name + ", table", benchmarkRating(ratingStrategy, true), "rating");
+    }
+}
+
+void benchmarkAgentLibrary()
+{
+    benchmarkPopulations();
+    benchmarkExplorationSharing();
+    benchmarkRatings();
+}
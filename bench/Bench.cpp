@@ -0,0 +1,119 @@
+#include <cmath>    // std::nan
+#include <iostream> // std::cout
+#include <memory>   // std::shared_ptr
+#include <string>   // std::string
+#include <utility>  // std::move
+#include <vector>   // std::vector
+
+#include "agent/Agent.h"                // Agent
+#include "agent/RatingStrategy.h"       // RatingStrategy
+#include "game/Game.h"                  // Game
+#include "game/Map.h"                   // Map
+#include "game/MapPool.h"               // MapPool
+#include "game/Rule.h"                  // Rule, RuleNumber
+#include "game/Topology.h"              // Topology
+#include "game_analyzer/GameAnalyzer.h" // GameAnalyzer
+
+#include "Bench.h"
+
+void printResult(const std::string &name, double nanoseconds, const std::string &unit)
+{
+    std::cout << "  " << name << ": " << nanoseconds << " ns/" << unit << "\n";
+}
+
+const std::vector<double> &getBenchmarkOpenings()
+{
+    static const std::vector<double> parametersOpenings{0.60524, 0.555841, -3.11708, 2.53163,
+                                                        3.65007, 2.34796, 2.11309, 2.44815};
+    return parametersOpenings;
+}
+
+const std::vector<RatingStrategy> &getBenchmarkRatings()
+{
+    static const std::vector<RatingStrategy> ratingStrategies{
+        RatingStrategy(std::vector<double>{0.42, 0.39, 5.9, -12.2, 0.5, 0.5, 60., 5.}, "tanh"),
+        RatingStrategy(std::vector<double>{0.5, 0.5, 40., -5., 0.1, 0.1, 60., 5.}, "tanh"),
+    };
+    return ratingStrategies;
+}
+
+double benchmarkScalarGames(int numberOfGames)
+{
+    const int numberOfRounds{20};
+    const int numberOfPlayers{5};
+    const std::vector<RatingStrategy> &ratingStrategies{getBenchmarkRatings()};
+    Game game(numberOfRounds, numberOfPlayers);
+    std::vector<Agent> agents(numberOfPlayers, Agent(getBenchmarkOpenings(), ratingStrategies[0]));
+
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iGame{0}; iGame < numberOfGames; ++iGame)
+            {
+                game.reset();
+                for (int iPlayer{0}; iPlayer < numberOfPlayers; ++iPlayer)
+                {
+                    agents[iPlayer].assignToGame(game.getAddress(), ratingStrategies[iPlayer % 2]);
+                }
+                for (int iRound{0}; iRound < numberOfRounds; ++iRound)
+                {
+                    for (auto &agent : agents)
+                    {
+                        agent.playARound();
+                    }
+                }
+            }
+        })};
+    return duration / numberOfGames;
+}
+
+double benchmarkMapSize(int numberOfGames, int numberOfCells, Analysis analysis,
+                        std::shared_ptr<const Topology> topology, const MapPool *maps)
+{
+    const int numberOfRounds{20};
+    const int numberOfPlayers{5};
+    const std::vector<RatingStrategy> &ratingStrategies{getBenchmarkRatings()};
+    Game game(numberOfRounds, 3, numberOfPlayers, Rule(RuleNumber::Rule2), Map::getShared(numberOfCells),
+              std::nan(""), std::move(topology));
+    std::vector<Agent> agents(numberOfPlayers, Agent(getBenchmarkOpenings(), ratingStrategies[0]));
+    GameAnalyzer analyzer(numberOfGames, numberOfPlayers);
+    analyzer.initialize(numberOfRounds, game.getNumberOfTurns(), game.getMap());
+    GameAnalyzer::Recorder recorder(analyzer);
+    if (analysis == Analysis::Online)
+    {
+        game.addObserver(recorder);
+    }
+
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iGame{0}; iGame < numberOfGames; ++iGame)
+            {
+                if (maps)
+                {
+                    game.reset(maps->getMap(iGame));
+                }
+                else
+                {
+                    game.reset();
+                }
+                recorder.startGame(iGame);
+                for (int iPlayer{0}; iPlayer < numberOfPlayers; ++iPlayer)
+                {
+                    agents[iPlayer].assignToGame(game.getAddress(), ratingStrategies[iPlayer % 2]);
+                }
+                for (int iRound{0}; iRound < numberOfRounds; ++iRound)
+                {
+                    for (auto &agent : agents)
+                    {
+                        agent.playARound();
+                    }
+                }
+                if (analysis == Analysis::PostHoc)
+                {
+                    analyzer.analyzeGame(iGame, game, agents);
+                }
+            }
+        })};
+    return duration / numberOfGames;
+}
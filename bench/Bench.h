@@ -0,0 +1,126 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cmath>   // std::nan
+#include <memory>  // std::shared_ptr
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+#include "agent/RatingStrategy.h"       // RatingStrategy
+#include "game/Map.h"                   // Map
+#include "game/MapPool.h"               // MapPool
+#include "game/Rule.h"                  // Rule, RuleNumber
+#include "game/Topology.h"              // Topology
+#include "game_analyzer/GameAnalyzer.h" // GameAnalyzer
+#include "game_batch/GameBatch.h"       // BasicGameBatch
+
+/**
+ * @brief Measure the duration of a call to `function`.
+ *
+ * @param function The function to time.
+ * @return The duration of the call in nanoseconds.
+ */
+template <typename Function>
+double measureNanoseconds(Function &&function)
+{
+    const auto start{std::chrono::steady_clock::now()};
+    function();
+    const auto end{std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+void printResult(const std::string &name, double nanoseconds, const std::string &unit);
+
+/**
+ * @brief Opening parameters of the calibrated agents of the example data.
+ */
+const std::vector<double> &getBenchmarkOpenings();
+
+/**
+ * @brief Rating strategies close to the collaborator and defector profiles of the example data.
+ */
+const std::vector<RatingStrategy> &getBenchmarkRatings();
+
+/**
+ * @brief Play complete games with simulated agents, one game at a time, and return the mean cost of a game.
+ */
+double benchmarkScalarGames(int numberOfGames);
+
+/**
+ * @brief How the games of `benchmarkMapSize` are analyzed.
+ */
+enum class Analysis
+{
+    None,    // The games are not analyzed
+    PostHoc, // Each game is analyzed from its history once it is over
+    Online,  // Each game is analyzed while it is played, by a `GameAnalyzer::Recorder`
+};
+
+/**
+ * @brief Play complete games with simulated agents on a map of the given size, and return the mean cost of
+ * a game.
+ *
+ * @param analysis How the games are analyzed, the cost including the analysis.
+ * @param topology The arrangement of the cells of the map, or null for none.
+ * @param maps The maps the games are played on, or null for the non-shuffled map.
+ */
+double benchmarkMapSize(int numberOfGames, int numberOfCells, Analysis analysis,
+                        std::shared_ptr<const Topology> topology = nullptr, const MapPool *maps = nullptr);
+
+/**
+ * @brief Play complete games with simulated agents, by batches of games in lockstep, and return the mean
+ * cost of a game.
+ *
+ * @param analyze If `true`, the games are also analyzed, and the cost includes the analysis.
+ * @param maps The maps the games are played on, or null for the non-shuffled map.
+ */
+template <typename Dimensions>
+double benchmarkBatchGames(int numberOfGames, int batchSize, const Dimensions &dimensions, bool analyze,
+                           const Rule &rule = Rule(RuleNumber::Rule2), const MapPool *maps = nullptr)
+{
+    const int numberOfPlayers{dimensions.numberOfPlayers()};
+    BasicGameBatch batch(batchSize, dimensions, rule, Map::getShared(dimensions.numberOfCells()), std::nan(""),
+                         getBenchmarkOpenings(), getBenchmarkRatings());
+    for (int iGame{0}; iGame < batchSize; ++iGame)
+    {
+        for (int iPlayer{0}; iPlayer < numberOfPlayers; ++iPlayer)
+        {
+            batch.setRatingStrategy(iGame, iPlayer, iPlayer % 2);
+        }
+    }
+
+    const int numberOfBatches{numberOfGames / batchSize};
+    GameAnalyzer analyzer(numberOfBatches * batchSize, numberOfPlayers);
+    analyzer.initialize(dimensions.numberOfRounds(), dimensions.numberOfTurns(), dimensions.numberOfCells());
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iBatch{0}; iBatch < numberOfBatches; ++iBatch)
+            {
+                batch.reset();
+                for (int iGame{0}; maps && iGame < batchSize; ++iGame)
+                {
+                    batch.setMap(iGame, maps->getMap(iBatch * batchSize + iGame));
+                }
+                batch.play();
+                for (int iGame{0}; analyze && iGame < batchSize; ++iGame)
+                {
+                    analyzer.analyzeGame(iBatch * batchSize + iGame, batch, iGame);
+                }
+            }
+        })};
+    return duration / (static_cast<double>(numberOfBatches) * batchSize);
+}
+
+// Benchmarks of each library of src, see the source of the same name
+
+void benchmarkGameLibrary();
+void benchmarkGameBatchLibrary();
+void benchmarkGameAnalyzerLibrary();
+void benchmarkAgentLibrary();
+void benchmarkRandomLibrary();
+void benchmarkMathLibrary();
+void benchmarkHelpersLibrary();
+
+#endif
@@ -0,0 +1,22 @@
+/**
+ * @file GameAnalyzerBench.cpp
+ * @brief Benchmarks of the analysis of the games, post hoc and online.
+ */
+
+#include <iostream> // std::cout
+
+#include "Bench.h"
+
+void benchmarkAnalysis()
+{
+    const int numberOfGames{20000};
+    std::cout << "Game + Agent + GameAnalyzer, 20 rounds x 5 players x 3 turns x 225 cells, one thread\n";
+    printResult("play", benchmarkMapSize(numberOfGames, 225, Analysis::None), "game");
+    printResult("play + post-hoc analysis", benchmarkMapSize(numberOfGames, 225, Analysis::PostHoc), "game");
+    printResult("play + online analysis", benchmarkMapSize(numberOfGames, 225, Analysis::Online), "game");
+}
+
+void benchmarkGameAnalyzerLibrary()
+{
+    benchmarkAnalysis();
+}
@@ -0,0 +1,77 @@
+/**
+ * @file GameBatchBench.cpp
+ * @brief Benchmarks of the batch engine: batch sizes, fixed dimensions, rules and shuffled maps.
+ */
+
+#include <iostream> // std::cout
+#include <string>   // std::string, std::to_string
+#include <utility>  // std::pair
+#include <vector>   // std::vector
+
+#include "game/Dimensions.h" // DynamicDimensions, ExperimentDimensions
+#include "game/MapPool.h"    // MapPool
+#include "game/Rule.h"       // Rule, RuleNumber
+
+#include "Bench.h"
+
+void benchmarkBatch()
+{
+    const int numberOfGames{4096};
+    const DynamicDimensions dimensions(20, 3, 5, 225);
+    std::cout << "Simulated games, 20 rounds x 5 players x 3 turns, one thread\n";
+    printResult("Game + Agent", benchmarkScalarGames(numberOfGames), "game");
+    for (const int batchSize : {1, 4, 8, 16, 32})
+    {
+        printResult("GameBatch of " + std::to_string(batchSize),
+                    benchmarkBatchGames(numberOfGames, batchSize, dimensions, false), "game");
+    }
+}
+
+void benchmarkDimensions()
+{
+    const int numberOfGames{4096};
+    const int batchSize{16};
+    std::cout << "Simulated games by batches of 16, 20 rounds x 5 players x 3 turns x 225 cells, one thread\n";
+    printResult("dynamic dimensions, play",
+                benchmarkBatchGames(numberOfGames, batchSize, DynamicDimensions(20, 3, 5, 225), false), "game");
+    printResult("fixed dimensions, play",
+                benchmarkBatchGames(numberOfGames, batchSize, ExperimentDimensions{}, false), "game");
+    printResult("dynamic dimensions, play + analysis",
+                benchmarkBatchGames(numberOfGames, batchSize, DynamicDimensions(20, 3, 5, 225), true), "game");
+    printResult("fixed dimensions, play + analysis",
+                benchmarkBatchGames(numberOfGames, batchSize, ExperimentDimensions{}, true), "game");
+}
+
+void benchmarkBatchRules()
+{
+    const std::vector<std::pair<std::string, RuleNumber>> rules{
+        {"rule 1", RuleNumber::Rule1},
+        {"rule 2", RuleNumber::Rule2},
+        {"rule 3", RuleNumber::Rule3},
+        {"rule 4", RuleNumber::Rule4},
+    };
+    std::cout << "Simulated games by batches of 16, 20 rounds x 5 players x 3 turns x 225 cells, one thread\n";
+    for (const auto &[name, ruleNumber] : rules)
+    {
+        printResult(name, benchmarkBatchGames(4096, 16, ExperimentDimensions{}, false, Rule(ruleNumber)), "game");
+    }
+}
+
+void benchmarkBatchRandomMaps()
+{
+    const int numberOfMaps{256};
+    std::cout << "Batches of games on shuffled maps, 20 rounds x 5 players x 3 turns, one thread\n";
+    const MapPool maps(225, numberOfMaps, 42);
+    printResult("225 cells, GameBatch of 16 + analysis, fixed map",
+                benchmarkBatchGames(4096, 16, ExperimentDimensions{}, true), "game");
+    printResult("225 cells, GameBatch of 16 + analysis, pool of " + std::to_string(numberOfMaps),
+                benchmarkBatchGames(4096, 16, ExperimentDimensions{}, true, Rule(RuleNumber::Rule2), &maps), "game");
+}
+
+void benchmarkGameBatchLibrary()
+{
+    benchmarkBatch();
+    benchmarkDimensions();
+    benchmarkBatchRules();
+    benchmarkBatchRandomMaps();
+}
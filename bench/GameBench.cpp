@@ -0,0 +1,361 @@
+/**
+ * @file GameBench.cpp
+ * @brief Benchmarks of the game library: moves, rules, maps, forks, topologies and colour queries.
+ */
+
+#include <algorithm> // std::copy, std::max, std::min, std::partial_sort
+#include <cmath>     // std::nan
+#include <iostream>  // std::cout
+#include <memory>    // std::make_shared, std::shared_ptr
+#include <numeric>   // std::iota
+#include <string>    // std::string
+#include <utility>   // std::pair
+#include <vector>    // std::vector
+
+#include "agent/Agent.h"     // Agent
+#include "game/ColorView.h"  // ColorView
+#include "game/Game.h"       // Game
+#include "game/Map.h"        // Map
+#include "game/MapPool.h"    // MapPool
+#include "game/Rule.h"       // Rule, RuleNumber
+#include "game/Topology.h"   // Neighbourhood, Topology
+#include "game/Validation.h" // CheckedValidation, UncheckedValidation
+
+#include "Bench.h"
+
+/**
+ * @brief Play complete games with a fixed sequence of moves and return the mean cost of a turn.
+ *
+ * The cost of a turn includes opening and rating a cell, and the round changes amortized over the turns.
+ *
+ * @param staticRule If `true`, the rule is dispatched once and the turns are scored by its policy, as the
+ *        agents do; otherwise the rule is looked up at each rating.
+ */
+template <typename Validation>
+double benchmarkTurn(int numberOfGames, const Rule &rule, bool staticRule = true)
+{
+    const int numberOfRounds{20};
+    const int numberOfPlayers{5};
+    Game game(numberOfRounds, numberOfPlayers, rule);
+    const int numberOfTurns{game.getNumberOfTurns()};
+    const int numberOfCells{game.getNumberOfCells()};
+
+    long long checksum{0};
+    const double duration{visitRule(
+        rule.getRuleNumber(),
+        [&](auto policy)
+        {
+            using RulePolicy = decltype(policy);
+            return measureNanoseconds(
+                [&]()
+                {
+                    for (int iGame{0}; iGame < numberOfGames; ++iGame)
+                    {
+                        game.reset();
+                        for (int iRound{0}; iRound < numberOfRounds; ++iRound)
+                        {
+                            for (int iPlayer{0}; iPlayer < numberOfPlayers; ++iPlayer)
+                            {
+                                for (int iTurn{0}; iTurn < numberOfTurns; ++iTurn)
+                                {
+                                    const int iCell{(iGame + iRound * 7 + iPlayer * numberOfTurns + iTurn) %
+                                                    numberOfCells};
+                                    const int rating{1 + (iPlayer + iTurn) % numberOfTurns};
+                                    game.openCell<Validation>(iPlayer, iCell);
+                                    if (staticRule)
+                                    {
+                                        game.rateCell<Validation, RulePolicy>(iPlayer, rating);
+                                    }
+                                    else
+                                    {
+                                        game.rateCell<Validation>(iPlayer, rating);
+                                    }
+                                }
+                            }
+                        }
+                        checksum += game.getScoreOfPlayer(0);
+                    }
+                });
+        })};
+
+    if (checksum == 0)
+    {
+        std::cout << "(checksum " << checksum << ")\n";
+    }
+    return duration / (static_cast<double>(numberOfGames) * numberOfRounds * numberOfPlayers * numberOfTurns);
+}
+
+void benchmarkValidation()
+{
+    const int numberOfGames{20000};
+    std::cout << "Game::openCell + Game::rateCell, 20 rounds x 5 players x 3 turns\n";
+    const Rule rule(RuleNumber::Rule2);
+    printResult("checked", benchmarkTurn<CheckedValidation>(numberOfGames, rule), "turn");
+    printResult("unchecked", benchmarkTurn<UncheckedValidation>(numberOfGames, rule), "turn");
+}
+
+void benchmarkRules()
+{
+    const std::vector<std::pair<std::string, RuleNumber>> rules{
+        {"rule 1", RuleNumber::Rule1},
+        {"rule 2", RuleNumber::Rule2},
+        {"rule 3", RuleNumber::Rule3},
+        {"rule 4", RuleNumber::Rule4},
+    };
+    std::cout << "Game::openCell + Game::rateCell (unchecked), 20 rounds x 5 players x 3 turns\n";
+    for (const auto &[name, ruleNumber] : rules)
+    {
+        printResult(name + ", rule looked up per turn",
+                    benchmarkTurn<UncheckedValidation>(20000, Rule(ruleNumber), false), "turn");
+        printResult(name + ", rule dispatched once", benchmarkTurn<UncheckedValidation>(20000, Rule(ruleNumber)),
+                    "turn");
+    }
+}
+
+void benchmarkMapSizes()
+{
+    std::cout << "Game + Agent on larger maps, 20 rounds x 5 players x 3 turns, one thread\n";
+    for (const int numberOfCells : {225, 2025, 22500, 225000, 1000125})
+    {
+        // About as many cells are played in total for each size, with at least 20 games
+        const int numberOfGames{std::max(20, 4500000 / numberOfCells)};
+        printResult(std::to_string(numberOfCells) + " cells, play",
+                    benchmarkMapSize(numberOfGames, numberOfCells, Analysis::None), "game");
+        printResult(std::to_string(numberOfCells) + " cells, play + analysis",
+                    benchmarkMapSize(numberOfGames, numberOfCells, Analysis::Online), "game");
+    }
+}
+
+void benchmarkRandomMaps()
+{
+    const int numberOfGames{20000};
+    const int numberOfMaps{256};
+    std::cout << "Games on shuffled maps, 20 rounds x 5 players x 3 turns, one thread\n";
+    for (const int numberOfCells : {225, 22500})
+    {
+        const std::string cells{std::to_string(numberOfCells) + " cells"};
+        printResult(cells + ", MapPool construction",
+                    measureNanoseconds([&]() { const MapPool maps(numberOfCells, numberOfMaps, 42); }) / numberOfMaps,
+                    "map");
+        const MapPool maps(numberOfCells, numberOfMaps, 42);
+
+        const int numberOfGamesOfSize{numberOfGames * 225 / numberOfCells};
+        printResult(cells + ", Game + online analysis, fixed map",
+                    benchmarkMapSize(numberOfGamesOfSize, numberOfCells, Analysis::Online), "game");
+        printResult(cells + ", Game + online analysis, pool of " + std::to_string(numberOfMaps),
+                    benchmarkMapSize(numberOfGamesOfSize, numberOfCells, Analysis::Online, nullptr, &maps), "game");
+    }
+}
+
+/**
+ * @brief Play continuations of a game from its state after some rounds, and return the mean cost of a
+ * continuation.
+ *
+ * @param fork If `true`, the continuations are forked from a snapshot of the game; otherwise the rounds
+ *        before the fork are played again for each continuation.
+ */
+double benchmarkContinuations(int numberOfContinuations, int forkRound, bool fork)
+{
+    const int numberOfRounds{20};
+    const int numberOfPlayers{5};
+    const std::vector<RatingStrategy> &ratingStrategies{getBenchmarkRatings()};
+    Game game(numberOfRounds, numberOfPlayers);
+    std::vector<Agent> agents(numberOfPlayers, Agent(getBenchmarkOpenings(), ratingStrategies[0]));
+    for (int iPlayer{0}; iPlayer < numberOfPlayers; ++iPlayer)
+    {
+        agents[iPlayer].assignToGame(game.getAddress(), ratingStrategies[iPlayer % 2]);
+    }
+    for (int iRound{0}; iRound < forkRound; ++iRound)
+    {
+        for (auto &agent : agents)
+        {
+            agent.playARound();
+        }
+    }
+    const Game::Snapshot snapshot{game.takeSnapshot()};
+
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iContinuation{0}; iContinuation < numberOfContinuations; ++iContinuation)
+            {
+                if (fork)
+                {
+                    game.restore(snapshot);
+                }
+                else
+                {
+                    game.reset();
+                }
+                for (int iPlayer{0}; iPlayer < numberOfPlayers; ++iPlayer)
+                {
+                    agents[iPlayer].assignToGame(game.getAddress(), ratingStrategies[iPlayer % 2]);
+                }
+                for (int iRound{game.getCurrentRound()}; iRound < numberOfRounds; ++iRound)
+                {
+                    for (auto &agent : agents)
+                    {
+                        agent.playARound();
+                    }
+                }
+            }
+        })};
+    return duration / numberOfContinuations;
+}
+
+void benchmarkForks()
+{
+    const int numberOfContinuations{10000};
+    std::cout << "Continuations of a game after round 10, 20 rounds x 5 players x 3 turns x 225 cells\n";
+    printResult("replayed from the start", benchmarkContinuations(numberOfContinuations, 10, false), "continuation");
+    printResult("forked from a snapshot", benchmarkContinuations(numberOfContinuations, 10, true), "continuation");
+}
+
+/**
+ * @brief Play a game on a map arranged on a grid, then return the mean cost of the smoothed color gradient of
+ * a cell.
+ */
+double benchmarkGradient(const std::shared_ptr<const Topology> &topology)
+{
+    const int numberOfRounds{20};
+    const int numberOfPlayers{5};
+    const int numberOfCells{topology->getNumberOfCells()};
+    Game game(numberOfRounds, 3, numberOfPlayers, Rule(RuleNumber::Rule2), Map::getShared(numberOfCells),
+              std::nan(""), topology);
+    std::vector<Agent> agents(numberOfPlayers, Agent(getBenchmarkOpenings(), getBenchmarkRatings()[0]));
+    for (auto &agent : agents)
+    {
+        agent.assignToGame(game.getAddress());
+    }
+    for (int iRound{0}; iRound < numberOfRounds - 1; ++iRound)
+    {
+        for (auto &agent : agents)
+        {
+            agent.playARound();
+        }
+    }
+
+    const int numberOfRepetitions{std::max(1, 4500000 / numberOfCells)};
+    const ColorView colors{game.getColors()};
+    double checksum{0.};
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iRepetition{0}; iRepetition < numberOfRepetitions; ++iRepetition)
+            {
+                for (int iCell{0}; iCell < numberOfCells; ++iCell)
+                {
+                    const auto [dx, dy]{colors.getSmoothedColorGradient(iCell)};
+                    checksum += dx + dy;
+                }
+            }
+        })};
+
+    if (checksum == 0.)
+    {
+        std::cout << "(checksum " << checksum << ")\n";
+    }
+    return duration / (static_cast<double>(numberOfRepetitions) * numberOfCells);
+}
+
+void benchmarkTopologies()
+{
+    std::cout << "Game + Agent on grids, 20 rounds x 5 players x 3 turns, one thread\n";
+    for (const int side : {15, 150})
+    {
+        const int numberOfCells{side * side};
+        const int numberOfGames{std::max(20, 4500000 / numberOfCells)};
+        const std::string grid{std::to_string(side) + "x" + std::to_string(side)};
+        printResult(grid + ", no topology", benchmarkMapSize(numberOfGames, numberOfCells, Analysis::None), "game");
+        for (const int radius : {1, 3})
+        {
+            const auto topology{std::make_shared<const Topology>(side, side, Neighbourhood::Moore, radius, false)};
+            const std::string name{grid + ", Moore radius " + std::to_string(radius)};
+            printResult(name, benchmarkMapSize(numberOfGames, numberOfCells, Analysis::None, topology), "game");
+            printResult(name + ", smoothed color gradient", benchmarkGradient(topology), "cell");
+        }
+    }
+}
+
+/**
+ * @brief Play a game on a map of the given size, then return the mean cost of finding its most rated cells.
+ *
+ * @param indexed If `true`, the cells are read from the index of cells sorted by color maintained by the
+ *        game; otherwise all the colors are scanned and partially sorted.
+ */
+double benchmarkTopCells(int numberOfCells, int numberOfTopCells, bool indexed)
+{
+    const int numberOfRounds{20};
+    const int numberOfPlayers{5};
+    Game game(numberOfRounds, 3, numberOfPlayers, Rule(RuleNumber::Rule2), Map::getShared(numberOfCells),
+              std::nan(""));
+    std::vector<Agent> agents(numberOfPlayers, Agent(getBenchmarkOpenings(), getBenchmarkRatings()[0]));
+    for (auto &agent : agents)
+    {
+        agent.assignToGame(game.getAddress());
+    }
+    for (int iRound{0}; iRound < numberOfRounds - 1; ++iRound)
+    {
+        for (auto &agent : agents)
+        {
+            agent.playARound();
+        }
+    }
+
+    const int numberOfQueries{std::max(10, 22500000 / numberOfCells)};
+    const ColorView colors{game.getColors()};
+    std::vector<int> cells(numberOfCells);
+    std::vector<int> topCells(numberOfTopCells);
+    long long checksum{0};
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iQuery{0}; iQuery < numberOfQueries; ++iQuery)
+            {
+                if (indexed)
+                {
+                    const std::vector<int> &cellsByColor{colors.getCellsByColor()};
+                    const int numberOfRatedCells{std::min(numberOfTopCells, static_cast<int>(cellsByColor.size()))};
+                    std::copy(cellsByColor.begin(), cellsByColor.begin() + numberOfRatedCells, topCells.begin());
+                }
+                else
+                {
+                    std::iota(cells.begin(), cells.end(), 0);
+                    std::partial_sort(cells.begin(), cells.begin() + numberOfTopCells, cells.end(),
+                                      [&colors](int iCell1, int iCell2)
+                                      { return colors[iCell1] > colors[iCell2]; });
+                    std::copy(cells.begin(), cells.begin() + numberOfTopCells, topCells.begin());
+                }
+                checksum += topCells[0];
+            }
+        })};
+
+    if (checksum == -1)
+    {
+        std::cout << "(checksum " << checksum << ")\n";
+    }
+    return duration / numberOfQueries;
+}
+
+void benchmarkTopCellQueries()
+{
+    std::cout << "10 most rated cells after 19 rounds, 5 players x 3 turns\n";
+    for (const int numberOfCells : {225, 22500, 1000125})
+    {
+        printResult(std::to_string(numberOfCells) + " cells, scan of the colors",
+                    benchmarkTopCells(numberOfCells, 10, false), "query");
+        printResult(std::to_string(numberOfCells) + " cells, index of the game",
+                    benchmarkTopCells(numberOfCells, 10, true), "query");
+    }
+}
+
+void benchmarkGameLibrary()
+{
+    benchmarkValidation();
+    benchmarkRules();
+    benchmarkMapSizes();
+    benchmarkRandomMaps();
+    benchmarkForks();
+    benchmarkTopologies();
+    benchmarkTopCellQueries();
+}
@@ -0,0 +1,97 @@
+/**
+ * @file HelpersBench.cpp
+ * @brief Benchmarks of the setup of the players of the simulated games.
+ */
+
+#include <cstddef>  // std::size_t
+#include <iostream> // std::cout
+#include <string>   // std::string
+#include <vector>   // std::vector
+
+#include <nlohmann/json.hpp> // nlohmann::json
+
+#include "agent/Agent.h"            // Agent
+#include "agent/OpeningStrategy.h"  // OpeningStrategy
+#include "agent/RatingStrategy.h"   // RatingStrategy
+#include "game/Game.h"              // Game
+#include "helpers/PlayerProfiles.h" // PlayerProfiles
+#include "random/myRandom.h"        // myRandom::randIndexWeighted
+
+#include "Bench.h"
+
+/**
+ * @brief How the players of a game are set up by `benchmarkPlayerSetup`.
+ */
+enum class PlayerSetup
+{
+    Json,       // Each agent is built from the opening parameters and the JSON of its profile
+    Prototypes, // `PlayerProfiles::makePlayers` copies the prototype agents of the profiles
+    Recycled,   // `PlayerProfiles::reassignPlayers` reassigns the agents of the previous game
+};
+
+/**
+ * @brief Set up the 5 players of games, and return the mean cost of the setup of a game.
+ */
+double benchmarkPlayerSetup(PlayerSetup setup)
+{
+    const int numberOfGames{2000};
+    const int numberOfPlayers{5};
+    const nlohmann::json parametersStars{
+        {"col", {{"functionType", "tanh"}, {"p0", {0.42, 0.39, 5.9, -12.2}}, {"p5", {0.5, 0.5, 60., 5.}}}},
+        {"neu", {{"functionType", "linear"}, {"p0", {0.52, 0.16}}, {"p5", {-0.02, 0.16}}}},
+        {"def", {{"functionType", "tanh"}, {"p0", {0.5, 0.5, 40., -5.}}, {"p5", {0.1, 0.1, 60., 5.}}}}};
+    const std::vector<std::string> profiles{"col", "neu", "def"};
+    const std::vector<double> fractions{0.2, 0.4, 0.4};
+    const PlayerProfiles playerProfiles(getBenchmarkOpenings(), parametersStars, fractions);
+    Game game(20, numberOfPlayers);
+    std::vector<Agent> agents{playerProfiles.makePlayers(numberOfPlayers, game)};
+
+    std::size_t checksum{0};
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iGame{0}; iGame < numberOfGames; ++iGame)
+            {
+                game.reset();
+                switch (setup)
+                {
+                case PlayerSetup::Json:
+                    agents.clear();
+                    for (int iPlayer{0}; iPlayer < numberOfPlayers; ++iPlayer)
+                    {
+                        const std::string &profile{profiles[myRandom::randIndexWeighted(fractions)]};
+                        agents.emplace_back(game.getAddress(), OpeningStrategy(getBenchmarkOpenings()),
+                                            RatingStrategy(parametersStars[profile]));
+                    }
+                    break;
+                case PlayerSetup::Prototypes:
+                    agents = playerProfiles.makePlayers(numberOfPlayers, game);
+                    break;
+                case PlayerSetup::Recycled:
+                    playerProfiles.reassignPlayers(agents, game);
+                    break;
+                }
+                checksum += agents.size();
+            }
+        })};
+
+    if (checksum == 0)
+    {
+        std::cout << "(checksum " << checksum << ")\n";
+    }
+    return duration / numberOfGames;
+}
+
+void benchmarkPlayerSetups()
+{
+    std::cout << "Setup of the players of a game, 20 rounds x 5 players x 3 turns x 225 cells, one thread\n";
+    printResult("agents built from the JSON", benchmarkPlayerSetup(PlayerSetup::Json), "game");
+    printResult("copies of the prototypes", benchmarkPlayerSetup(PlayerSetup::Prototypes), "game");
+    printResult("recycled agents", benchmarkPlayerSetup(PlayerSetup::Recycled), "game");
+    printResult("complete game, for comparison", benchmarkScalarGames(2000), "game");
+}
+
+void benchmarkHelpersLibrary()
+{
+    benchmarkPlayerSetups();
+}
@@ -0,0 +1,139 @@
+/**
+ * @file MathBench.cpp
+ * @brief Benchmarks of the elementary functions of the strategies, <cmath> against myMath.
+ */
+
+#include <algorithm> // std::transform
+#include <cmath>     // std::exp, std::log, std::pow, std::tanh
+#include <cstddef>   // std::size_t
+#include <iostream>  // std::cout
+#include <string>    // std::string
+#include <utility>   // std::pair
+#include <vector>    // std::vector
+
+#include "math/VectorMath.h" // myMath::exp, myMath::pow, myMath::tanh
+#include "random/myRandom.h" // myRandom::rand
+
+#include "Bench.h"
+
+/**
+ * @brief The elementary functions compared by `benchmarkVectorMath`.
+ */
+enum class MathFunction
+{
+    Exp,  // `exp(x)` for the arguments of the gaussian rating functions
+    Pow,  // `pow(color, exponent)` for the colors of a game and the exponent of the benchmark openings
+    Tanh, // `tanh(x)` for the arguments of the tanh rating functions
+};
+
+/**
+ * @brief Draw random arguments for a function, in the range the simulation uses it on.
+ */
+std::vector<double> getMathArguments(MathFunction function, int numberOfArguments)
+{
+    std::vector<double> arguments(numberOfArguments);
+    for (double &argument : arguments)
+    {
+        switch (function)
+        {
+        case MathFunction::Exp:
+            argument = myRandom::rand(-10., 0.);
+            break;
+        case MathFunction::Pow:
+            // Colors from 1e-5, the lowest color of a cell of an experiment, to 1
+            argument = std::exp(myRandom::rand(std::log(1e-5), 0.));
+            break;
+        case MathFunction::Tanh:
+            argument = myRandom::rand(-5., 5.);
+            break;
+        }
+    }
+    return arguments;
+}
+
+/**
+ * @brief Compute a function on every argument, with `<cmath>` or with the vectorized kernels of `myMath`.
+ */
+void computeMathFunction(MathFunction function, bool vectorized, const std::vector<double> &arguments,
+                         std::vector<double> &results)
+{
+    const double exponent{getBenchmarkOpenings()[1]};
+    const std::size_t n{arguments.size()};
+    switch (function)
+    {
+    case MathFunction::Exp:
+        if (vectorized)
+        {
+            myMath::exp(arguments.data(), results.data(), n);
+        }
+        else
+        {
+            std::transform(arguments.begin(), arguments.end(), results.begin(), [](double x) { return std::exp(x); });
+        }
+        break;
+    case MathFunction::Pow:
+        if (vectorized)
+        {
+            myMath::pow(arguments.data(), exponent, results.data(), n);
+        }
+        else
+        {
+            std::transform(arguments.begin(), arguments.end(), results.begin(),
+                           [exponent](double x) { return std::pow(x, exponent); });
+        }
+        break;
+    case MathFunction::Tanh:
+        if (vectorized)
+        {
+            myMath::tanh(arguments.data(), results.data(), n);
+        }
+        else
+        {
+            std::transform(arguments.begin(), arguments.end(), results.begin(), [](double x) { return std::tanh(x); });
+        }
+        break;
+    }
+}
+
+/**
+ * @brief Compute a function on the 225 cells of a map many times, and return the mean cost of a value.
+ */
+double benchmarkMathFunction(MathFunction function, bool vectorized)
+{
+    const std::vector<double> arguments{getMathArguments(function, 225)};
+    std::vector<double> results(arguments.size());
+    const int numberOfRepetitions{20000};
+    double checksum{0.};
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iRepetition{0}; iRepetition < numberOfRepetitions; ++iRepetition)
+            {
+                computeMathFunction(function, vectorized, arguments, results);
+                checksum += results[iRepetition % results.size()];
+            }
+        })};
+
+    if (checksum == 0.)
+    {
+        std::cout << "(checksum " << checksum << ")\n";
+    }
+    return duration / (static_cast<double>(numberOfRepetitions) * arguments.size());
+}
+
+void benchmarkVectorMath()
+{
+    std::cout << "Elementary functions of the strategies, <cmath> and vectorized kernels of myMath\n";
+    const std::vector<std::pair<MathFunction, std::string>> functions{
+        {MathFunction::Exp, "exp"}, {MathFunction::Pow, "pow"}, {MathFunction::Tanh, "tanh"}};
+    for (const auto &[function, name] : functions)
+    {
+        printResult(name + ", <cmath>", benchmarkMathFunction(function, false), "value");
+        printResult(name + ", myMath", benchmarkMathFunction(function, true), "value");
+    }
+}
+
+void benchmarkMathLibrary()
+{
+    benchmarkVectorMath();
+}
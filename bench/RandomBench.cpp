@@ -0,0 +1,125 @@
+/**
+ * @file RandomBench.cpp
+ * @brief Benchmarks of the weighted draws of an index.
+ */
+
+#include <algorithm> // std::max
+#include <cstddef>   // std::size_t
+#include <iostream>  // std::cout
+#include <random>    // std::discrete_distribution, std::mt19937
+#include <string>    // std::string, std::to_string
+#include <vector>    // std::vector
+
+#include "random/AliasSampler.h"      // myRandom::AliasSampler
+#include "random/CumulativeSampler.h" // myRandom::CumulativeSampler
+#include "random/myRandom.h"          // myRandom::rand, myRandom::randIndexWeighted
+
+#include "Bench.h"
+
+/**
+ * @brief How the indices of `benchmarkSampler` are drawn.
+ */
+enum class Sampling
+{
+    DiscreteDistribution, // A `std::discrete_distribution` is built for each draw
+    Scan,                 // `myRandom::randIndexWeighted` scans the weights for each draw
+    Cumulative,           // A `myRandom::CumulativeSampler` is built once
+    Alias,                // A `myRandom::AliasSampler` is built once
+};
+
+/**
+ * @brief Draw indices from fixed random weights, and return the mean cost of a draw.
+ *
+ * The cost of building the samplers is not included, see `benchmarkSamplerConstruction`.
+ */
+double benchmarkSampler(int numberOfWeights, Sampling sampling)
+{
+    std::vector<double> weights(numberOfWeights);
+    for (double &weight : weights)
+    {
+        weight = myRandom::rand();
+    }
+    const myRandom::CumulativeSampler cumulativeSampler(weights);
+    const myRandom::AliasSampler aliasSampler(weights);
+    std::mt19937 engine(42);
+
+    // The draws that scan the weights are fewer on large distributions
+    const bool isLinear{sampling == Sampling::DiscreteDistribution || sampling == Sampling::Scan};
+    const int numberOfDraws{isLinear ? std::max(200, 20000000 / numberOfWeights) : 1000000};
+    std::size_t checksum{0};
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iDraw{0}; iDraw < numberOfDraws; ++iDraw)
+            {
+                switch (sampling)
+                {
+                case Sampling::DiscreteDistribution:
+                    checksum += std::discrete_distribution<std::size_t>(weights.begin(), weights.end())(engine);
+                    break;
+                case Sampling::Scan:
+                    checksum += myRandom::randIndexWeighted(weights);
+                    break;
+                case Sampling::Cumulative:
+                    checksum += cumulativeSampler.draw();
+                    break;
+                case Sampling::Alias:
+                    checksum += aliasSampler.draw();
+                    break;
+                }
+            }
+        })};
+
+    if (checksum == 0)
+    {
+        std::cout << "(checksum " << checksum << ")\n";
+    }
+    return duration / numberOfDraws;
+}
+
+/**
+ * @brief Build a sampler from random weights, and return the mean cost of a construction.
+ */
+template <typename Sampler>
+double benchmarkSamplerConstruction(int numberOfWeights)
+{
+    std::vector<double> weights(numberOfWeights);
+    for (double &weight : weights)
+    {
+        weight = myRandom::rand();
+    }
+    Sampler sampler;
+    const int numberOfConstructions{std::max(100, 20000000 / numberOfWeights)};
+    const double duration{measureNanoseconds(
+        [&]()
+        {
+            for (int iConstruction{0}; iConstruction < numberOfConstructions; ++iConstruction)
+            {
+                sampler.assign(weights);
+            }
+        })};
+    return duration / numberOfConstructions;
+}
+
+void benchmarkSamplers()
+{
+    std::cout << "Weighted draws of an index\n";
+    for (const int numberOfWeights : {6, 225, 100000})
+    {
+        const std::string weights{std::to_string(numberOfWeights) + " weights"};
+        printResult(weights + ", std::discrete_distribution per draw",
+                    benchmarkSampler(numberOfWeights, Sampling::DiscreteDistribution), "draw");
+        printResult(weights + ", randIndexWeighted", benchmarkSampler(numberOfWeights, Sampling::Scan), "draw");
+        printResult(weights + ", CumulativeSampler", benchmarkSampler(numberOfWeights, Sampling::Cumulative), "draw");
+        printResult(weights + ", AliasSampler", benchmarkSampler(numberOfWeights, Sampling::Alias), "draw");
+        printResult(weights + ", CumulativeSampler construction",
+                    benchmarkSamplerConstruction<myRandom::CumulativeSampler>(numberOfWeights), "sampler");
+        printResult(weights + ", AliasSampler construction",
+                    benchmarkSamplerConstruction<myRandom::AliasSampler>(numberOfWeights), "sampler");
+    }
+}
+
+void benchmarkRandomLibrary()
+{
+    benchmarkSamplers();
+}
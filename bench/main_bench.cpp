@@ -0,0 +1,27 @@
+/**
+ * @file main_bench.cpp
+ * @brief Benchmark entry point: measures the cost of the hot paths of the simulation.
+ *
+ * The benchmarks of each library of src are in the source of the same name, see `Bench.h`. They only
+ * measure durations: the optimized paths are checked against reference implementations by the programs of
+ * check/.
+ */
+
+#include "random/myRandom.h" // myRandom::seed
+
+#include "Bench.h"
+
+int main()
+{
+    myRandom::seed(42);
+
+    benchmarkGameLibrary();
+    benchmarkGameBatchLibrary();
+    benchmarkGameAnalyzerLibrary();
+    benchmarkAgentLibrary();
+    benchmarkRandomLibrary();
+    benchmarkMathLibrary();
+    benchmarkHelpersLibrary();
+
+    return 0;
+}
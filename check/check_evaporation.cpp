@@ -0,0 +1,192 @@
+/**
+ * @file check_evaporation.cpp
+ * @brief Check of the lazy evaporation of `Game` against a reference evaporating every cell at every round.
+ *
+ * `Game` applies the evaporation through a common scale factor, folded into the stars when it gets too small
+ * (`Game::rescaleStars`). A game on a 15 x 15 grid is played with random moves for enough rounds to rescale
+ * the stars several times, and after every round its colors, its index of the cells sorted by color and its
+ * smoothed colors are compared with those computed from stars evaporated cell by cell, as before the lazy
+ * scale. The program fails if a color differs by more than `tolerance`.
+ */
+
+#include <algorithm> // std::max
+#include <cmath>     // std::abs
+#include <cstddef>   // std::size_t
+#include <iostream>  // std::cout, std::cerr
+#include <memory>    // std::make_shared
+#include <vector>    // std::vector
+
+#include "game/ColorView.h"  // ColorView
+#include "game/Game.h"       // Game
+#include "game/Map.h"        // Map
+#include "game/Rule.h"       // Rule, RuleNumber
+#include "game/Topology.h"   // Topology
+#include "game/Validation.h" // UncheckedValidation
+#include "random/myRandom.h" // myRandom::randInt, myRandom::seed
+
+namespace
+{
+    // Largest absolute difference allowed between a color and its reference, the colors being at most 1
+    constexpr double tolerance{1e-12};
+
+    /**
+     * @brief Reference colors: the stars of every cell are evaporated at every round.
+     */
+    class ReferenceColors
+    {
+    public:
+        ReferenceColors(int numberOfCells, double tauEvaporation)
+            : m_stars(numberOfCells, 0.), m_evaporation{1. - 1. / tauEvaporation}
+        {
+        }
+
+        void evaporate()
+        {
+            for (double &stars : m_stars)
+            {
+                stars *= m_evaporation;
+            }
+        }
+
+        void addStars(int iCell, int stars) { m_stars[iCell] += stars; }
+
+        [[nodiscard]] std::vector<double> getColors() const
+        {
+            double sumOfStars{0.};
+            for (const double stars : m_stars)
+            {
+                sumOfStars += stars;
+            }
+            std::vector<double> colors(m_stars.size(), 0.);
+            for (std::size_t iCell{0}; sumOfStars > 0. && iCell < colors.size(); ++iCell)
+            {
+                colors[iCell] = m_stars[iCell] / sumOfStars;
+            }
+            return colors;
+        }
+
+    private:
+        std::vector<double> m_stars;
+        const double m_evaporation;
+    };
+
+    /**
+     * @brief Check that the cells sorted by color are exactly the cells holding stars, by decreasing stars.
+     *
+     * The order is checked on the stars rather than on the colors, which may round equal stars that differ
+     * by their last bits to the same color.
+     *
+     * @return The number of errors found.
+     */
+    int checkCellsByColor(const ColorView &colors)
+    {
+        int numberOfErrors{0};
+        const std::vector<double> &stars{colors.getStars()};
+        const std::vector<int> &cellsByColor{colors.getCellsByColor()};
+        int numberOfColoredCells{0};
+        for (const double starsOfCell : stars)
+        {
+            numberOfColoredCells += starsOfCell > 0.;
+        }
+        if (static_cast<int>(cellsByColor.size()) != numberOfColoredCells)
+        {
+            ++numberOfErrors;
+        }
+        for (std::size_t i{1}; i < cellsByColor.size(); ++i)
+        {
+            const double previous{stars[cellsByColor[i - 1]]};
+            const double current{stars[cellsByColor[i]]};
+            if (previous < current || (previous == current && cellsByColor[i - 1] > cellsByColor[i]))
+            {
+                ++numberOfErrors;
+            }
+        }
+        return numberOfErrors;
+    }
+
+    /**
+     * @brief Play a game with random moves, and compare its colors with the reference after every round.
+     *
+     * @return The largest difference between a color, or a smoothed color, and its reference.
+     */
+    double checkEvaporation(double tauEvaporation, int numberOfRounds, int &numberOfIndexErrors)
+    {
+        const int numberOfPlayers{5};
+        const int numberOfTurns{3};
+        const auto topology{std::make_shared<const Topology>(15, 15, Neighbourhood::Moore, 1, false)};
+        const int numberOfCells{topology->getNumberOfCells()};
+        Game game(numberOfRounds, numberOfTurns, numberOfPlayers, Rule(RuleNumber::Rule2),
+                  Map::getShared(numberOfCells), tauEvaporation, topology);
+        ReferenceColors reference(numberOfCells, tauEvaporation);
+
+        double maxDifference{0.};
+        for (int iRound{0}; iRound < numberOfRounds; ++iRound)
+        {
+            for (int iPlayer{0}; iPlayer < numberOfPlayers; ++iPlayer)
+            {
+                for (int iTurn{0}; iTurn < numberOfTurns; ++iTurn)
+                {
+                    // The 15 cells of a round are distinct, and each cell is rated about every 15 rounds
+                    const int iCell{(iRound * 11 + iPlayer * numberOfTurns + iTurn) % numberOfCells};
+                    const int stars{myRandom::randInt(0, 5)};
+                    game.openCell<UncheckedValidation>(iPlayer, iCell);
+                    game.rateCell<UncheckedValidation>(iPlayer, stars);
+                }
+            }
+
+            // The stars of the round are given after the evaporation of the previous ones
+            reference.evaporate();
+            for (int iPlayer{0}; iPlayer < numberOfPlayers; ++iPlayer)
+            {
+                const GameHistory::RoundView round{game.getHistory().getRound(iPlayer, iRound)};
+                for (int iTurn{0}; iTurn < round.size(); ++iTurn)
+                {
+                    reference.addStars(round.getCell(iTurn), round.getRating(iTurn));
+                }
+            }
+
+            const ColorView colors{game.getColors()};
+            const std::vector<double> expected{reference.getColors()};
+            for (int iCell{0}; iCell < numberOfCells; ++iCell)
+            {
+                maxDifference = std::max(maxDifference, std::abs(colors[iCell] - expected[iCell]));
+
+                double expectedSmoothed{expected[iCell]};
+                for (const int iNeighbour : topology->getNeighbours(iCell))
+                {
+                    expectedSmoothed += expected[iNeighbour];
+                }
+                expectedSmoothed /= topology->getNeighbours(iCell).size() + 1;
+                maxDifference = std::max(maxDifference, std::abs(colors.getSmoothedColor(iCell) - expectedSmoothed));
+            }
+            numberOfIndexErrors += checkCellsByColor(colors);
+        }
+        return maxDifference;
+    }
+}
+
+int main()
+{
+    myRandom::seed(42);
+
+    // Enough rounds for the scale to be folded into the stars at least once for tau <= 5
+    const int numberOfRounds{3000};
+    bool success{true};
+    for (const double tauEvaporation : {1., 1.5, 2., 5., 20., 1000.})
+    {
+        int numberOfIndexErrors{0};
+        const double maxDifference{checkEvaporation(tauEvaporation, numberOfRounds, numberOfIndexErrors)};
+        const bool passed{maxDifference <= tolerance && numberOfIndexErrors == 0};
+        std::cout << "tau = " << tauEvaporation << ": largest color difference " << maxDifference << ", "
+                  << numberOfIndexErrors << " errors of the cells sorted by color" << (passed ? "" : " FAILED")
+                  << "\n";
+        success = success && passed;
+    }
+
+    if (!success)
+    {
+        std::cerr << "The lazy evaporation differs from the reference by more than " << tolerance << "\n";
+        return 1;
+    }
+    return 0;
+}
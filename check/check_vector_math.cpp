@@ -0,0 +1,218 @@
+/**
+ * @file check_vector_math.cpp
+ * @brief Check of the vectorized elementary functions of `myMath` against those of `<cmath>`.
+ *
+ * The program is built twice: with the libraries of src, and with a second build of the libraries with
+ * `STIGMER_SCALAR_MATH`, which replaces the functions of `myMath` by those of `<cmath>`. Both programs simulate
+ * the same games as `main_obs`, with the parameters of the example data. The `<cmath>` program writes the
+ * observables of the games to a file, which the other program reads: it fails if the mean score, the
+ * performances q and Q of a round or the probability of having found the best cell by a round differ by more
+ * than `observableTolerance`, or if a function of `myMath` exceeds the bound on its error stated in
+ * VectorMath.h.
+ *
+ * Usage: check_vector_math <directory of the parameters> <file of the observables of <cmath>>
+ */
+
+#include <algorithm> // std::max
+#include <cmath>     // std::abs, std::exp, std::log, std::nextafter, std::pow, std::tanh
+#include <cstddef>   // std::size_t
+#include <fstream>   // std::ifstream, std::ofstream
+#include <iomanip>   // std::setprecision
+#include <iostream>  // std::cout, std::cerr
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+#include <nlohmann/json.hpp> // nlohmann::json, nlohmann::json::parse
+
+#include "agent/RatingStrategy.h"       // RatingStrategy
+#include "game/Dimensions.h"            // DynamicDimensions
+#include "game_analyzer/GameAnalyzer.h" // GameAnalyzer
+#include "helpers/helper_all.h"         // readParameters, initializeRatingStrategies, simulateGames
+#include "math/VectorMath.h"            // myMath::exp, myMath::pow, myMath::tanh
+#include "random/myRandom.h"            // myRandom::rand, myRandom::seed
+
+namespace
+{
+    // Largest absolute difference allowed between an observable of `myMath` and that of `<cmath>`, the
+    // observables being scores and probabilities in [0, 1]. `myRandom::seed` seeds the engine of every thread,
+    // so both programs draw the same uniform numbers, and the games only differ if a draw compares one of them
+    // with a probability that changed in its last bits.
+    constexpr double observableTolerance{1e-3};
+
+    const int numberOfGames{20000};
+    const int numberOfRounds{20};
+
+    /**
+     * @brief Simulate the games of `main_obs` with the parameters of the example data.
+     *
+     * @return The mean score, then q, Q and the probability of having found the best cell at each round.
+     */
+    std::vector<double> computeObservables(const std::string &pathParameters)
+    {
+        const int numberOfTurns{3};
+        const int numberOfPlayers{5};
+        const int numberOfCells{225};
+        const std::vector<double> fractionPlayersProfiles{readParameters(pathParameters + "players_profiles.txt")};
+        const std::vector<double> parametersOpenings{readParameters(pathParameters + "cells.txt")};
+        const nlohmann::json parametersRatings(nlohmann::json::parse(std::ifstream(pathParameters + "stars.json")));
+
+        GameAnalyzer analyzer(numberOfGames, numberOfPlayers);
+        analyzer.initialize(numberOfRounds, numberOfTurns, numberOfCells);
+        myRandom::seed(42);
+        simulateGames(analyzer, numberOfGames, DynamicDimensions(numberOfRounds, numberOfTurns, numberOfPlayers,
+                                                                 numberOfCells),
+                      16, parametersOpenings, initializeRatingStrategies(parametersRatings), fractionPlayersProfiles);
+
+        std::vector<double> observables{analyzer.get_S_mean()};
+        for (const std::vector<double> &observable : {analyzer.get_q(), analyzer.get_Q(), analyzer.get_find99()})
+        {
+            observables.insert(observables.end(), observable.begin(), observable.end());
+        }
+        return observables;
+    }
+
+#ifndef STIGMER_SCALAR_MATH
+    /**
+     * @brief Return the error of `result` relative to `expected`, in units in the last place of `expected`.
+     */
+    double computeUlpError(double result, double expected)
+    {
+        const double ulp{std::nextafter(std::abs(expected), HUGE_VAL) - std::abs(expected)};
+        return std::abs(result - expected) / ulp;
+    }
+
+    /**
+     * @brief Draw arguments uniformly in [low, high].
+     */
+    std::vector<double> drawArguments(double low, double high)
+    {
+        std::vector<double> arguments(1000000);
+        for (double &argument : arguments)
+        {
+            argument = myRandom::rand(low, high);
+        }
+        return arguments;
+    }
+
+    /**
+     * @brief Check the array functions of `myMath` against `<cmath>`, with the bounds of VectorMath.h.
+     *
+     * @param exponent The exponent of the colors in the opening strategy of the example data.
+     * @return `true` if every error is within its bound.
+     */
+    bool checkErrorBounds(double exponent)
+    {
+        bool success{true};
+        std::vector<double> results(1000000);
+
+        // exp: below 2 ulp
+        const std::vector<double> expArguments{drawArguments(-700., 700.)};
+        myMath::exp(expArguments.data(), results.data(), results.size());
+        double maxError{0.};
+        for (std::size_t i{0}; i < results.size(); ++i)
+        {
+            maxError = std::max(maxError, computeUlpError(results[i], std::exp(expArguments[i])));
+        }
+        std::cout << "exp: largest error " << maxError << " ulp\n";
+        success = success && maxError < 2.;
+
+        // pow: below 2 + |exponent ln(x)| ulp, for colors from 1e-5, the lowest color of a cell of an experiment
+        std::vector<double> colors{drawArguments(std::log(1e-5), 0.)};
+        for (double &color : colors)
+        {
+            color = std::exp(color);
+        }
+        for (const double powExponent : {exponent, -1.5, 0.25, 4.})
+        {
+            myMath::pow(colors.data(), powExponent, results.data(), results.size());
+            double maxRatio{0.};
+            for (std::size_t i{0}; i < results.size(); ++i)
+            {
+                const double error{computeUlpError(results[i], std::pow(colors[i], powExponent))};
+                maxRatio = std::max(maxRatio, error / (2. + std::abs(powExponent * std::log(colors[i]))));
+            }
+            std::cout << "pow, exponent " << powExponent << ": largest ratio of the error to its bound " << maxRatio
+                      << "\n";
+            success = success && maxRatio < 1.;
+        }
+
+        // tanh: at most 4 ulp, including the saturated arguments
+        const std::vector<double> tanhArguments{drawArguments(-25., 25.)};
+        myMath::tanh(tanhArguments.data(), results.data(), results.size());
+        maxError = 0.;
+        for (std::size_t i{0}; i < results.size(); ++i)
+        {
+            maxError = std::max(maxError, computeUlpError(results[i], std::tanh(tanhArguments[i])));
+        }
+        std::cout << "tanh: largest error " << maxError << " ulp\n";
+        success = success && maxError <= 4.;
+
+        return success;
+    }
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <directory of the parameters> <file of the observables of <cmath>>\n";
+        return 2;
+    }
+    const std::string pathParameters{std::string(argv[1]) + "/"};
+    const std::string pathObservables{argv[2]};
+    const std::vector<double> observables{computeObservables(pathParameters)};
+
+#ifdef STIGMER_SCALAR_MATH
+    std::ofstream file(pathObservables);
+    file << std::setprecision(17);
+    for (const double observable : observables)
+    {
+        file << observable << "\n";
+    }
+    return file ? 0 : 1;
+#else
+    std::ifstream file(pathObservables);
+    std::vector<double> expected;
+    for (double observable; file >> observable;)
+    {
+        expected.push_back(observable);
+    }
+    if (expected.size() != observables.size())
+    {
+        std::cerr << "The observables of <cmath> could not be read from " << pathObservables << "\n";
+        return 1;
+    }
+
+    const std::vector<std::string> names{"S_mean", "q", "Q", "find99"};
+    bool success{true};
+    for (std::size_t iName{0}; iName < names.size(); ++iName)
+    {
+        // The mean score, then one value per round for each other observable
+        const std::size_t begin{iName == 0 ? 0 : 1 + (iName - 1) * numberOfRounds};
+        const std::size_t end{iName == 0 ? 1 : begin + numberOfRounds};
+        double maxDifference{0.};
+        for (std::size_t i{begin}; i < end; ++i)
+        {
+            maxDifference = std::max(maxDifference, std::abs(observables[i] - expected[i]));
+        }
+        const bool passed{maxDifference <= observableTolerance};
+        std::cout << names[iName] << ": largest difference with <cmath> " << maxDifference
+                  << (passed ? "" : " FAILED") << "\n";
+        success = success && passed;
+    }
+
+    myRandom::seed(42);
+    if (!success)
+    {
+        std::cerr << "The observables of myMath differ from those of <cmath> by more than " << observableTolerance
+                  << "\n";
+    }
+    if (!checkErrorBounds(readParameters(pathParameters + "cells.txt")[1]))
+    {
+        std::cerr << "A function of myMath exceeds the bound on its error stated in VectorMath.h\n";
+        success = false;
+    }
+    return success ? 0 : 1;
+#endif
+}
@@ -2,13 +2,16 @@
 #include <cassert>
 #include <cmath>
 #include <numeric>
+#include <stdexcept>
 #include <vector>
 
 #include "agent/Agent.h"
-#include "agent/Cell.h"
+#include "agent/BestCells.h"
+#include "agent/ExplorationCache.h"
 #include "agent/OpeningStrategy.h"
 #include "agent/RatingStrategy.h"
 #include "game/Game.h"
+#include "game/Rule.h"
 #include "random/myRandom.h"
 
 Agent::Agent(Game *pGame,
@@ -17,11 +20,10 @@ Agent::Agent(Game *pGame,
     : mp_Game{pGame},
       m_iAgent{mp_Game->registerPlayer()},
       m_numberOfTurns{mp_Game->getNumberOfTurns()},
-      m_numberOfCells{mp_Game->getNumberOfCells()},
       m_openingStrategy{openingStrategy},
       m_ratingStrategy{ratingStrategy},
       m_round{0},
-      m_bestCells{std::vector<std::vector<Cell>>(mp_Game->getNumberOfRounds(), std::vector<Cell>(m_numberOfTurns, {-1, -1}))}
+      m_bestCells{mp_Game->getNumberOfRounds(), m_numberOfTurns}
 {
 }
 
@@ -33,53 +35,73 @@ Agent::Agent(const OpeningStrategy &openingStrategy,
 {
 }
 
-void Agent::assignToGame(Game *pGame)
+void Agent::assignToGame(Game *pGame, ExplorationCache *explorationCache)
 {
+    if (explorationCache && &explorationCache->getGame() != pGame)
+    {
+        throw std::invalid_argument("Agent::assignToGame: The exploration cache is attached to another game.");
+    }
     mp_Game = pGame;
     m_iAgent = mp_Game->registerPlayer();
     m_numberOfTurns = mp_Game->getNumberOfTurns();
-    m_numberOfCells = mp_Game->getNumberOfCells();
     m_round = 0;
-    m_bestCells = std::vector<std::vector<Cell>>(mp_Game->getNumberOfRounds(), std::vector<Cell>(m_numberOfTurns, {-1, -1}));
+    m_openingStrategy.reset(explorationCache);
+    m_bestCells.reset(mp_Game->getNumberOfRounds(), m_numberOfTurns);
+
+    // A game restored from a snapshot has already played some rounds, whose best cells are in its history
+    for (m_round = 0; m_round < mp_Game->getCurrentRound(); ++m_round)
+    {
+        m_bestCells.record(m_round, mp_Game->getHistory().getRound(m_iAgent, m_round));
+    }
+}
+
+void Agent::assignToGame(Game *pGame, const RatingStrategy &ratingStrategy, ExplorationCache *explorationCache)
+{
+    m_ratingStrategy = ratingStrategy;
+    assignToGame(pGame, explorationCache);
 }
 
 void Agent::playARound()
+{
+    // The rule is dispatched once per round, so that the turns are scored without any indirection
+    visitRule(mp_Game->getRule().getRuleNumber(), [this](auto rule) { playARoundWithRule<decltype(rule)>(); });
+}
+
+template <typename RulePolicy>
+void Agent::playARoundWithRule()
 {
     m_round = mp_Game->getCurrentRound();
-    std::vector<Cell> cellsPlayed;
     for (int iTurn{0}; iTurn < m_numberOfTurns; ++iTurn)
     {
-        const int iCell{m_openingStrategy.chooseCell(m_round, mp_Game->getColors(), m_bestCells, cellsPlayed)};
-        const int vCell{mp_Game->openCell(m_iAgent, iCell)};
-        mp_Game->rateCell(m_iAgent, m_ratingStrategy.chooseRating(vCell));
-        cellsPlayed.push_back({iCell, vCell});
+        const int iCell{m_openingStrategy.chooseCell(m_round, mp_Game->getColors(), m_bestCells,
+                                                     mp_Game->getCellsPlayedDuringTheRound(m_iAgent))};
+        const int vCell{mp_Game->openCell<Validation>(m_iAgent, iCell)};
+        mp_Game->rateCell<Validation, RulePolicy>(m_iAgent, m_ratingStrategy.chooseRating(vCell));
     }
-    updateBestCells(cellsPlayed);
+    // The last rating of the round may have moved the game to the next round
+    m_bestCells.record(m_round, mp_Game->getHistory().getRound(m_iAgent, m_round));
 }
 
-void Agent::updateBestCells(const std::vector<Cell> &cellsPlayed)
+void Agent::playARoundInParallel(std::vector<Agent> &agents)
 {
-    std::vector<Cell> bestCells(m_numberOfTurns, {-1, -1});
-    for (const auto &cellPlayed : cellsPlayed)
+    const int numberOfAgents{static_cast<int>(agents.size())};
+#pragma omp parallel for schedule(static)
+    for (int iAgent = 0; iAgent < numberOfAgents; ++iAgent)
     {
-        for (int i{0}; i < bestCells.size(); ++i)
-        {
-            if (cellPlayed.value > bestCells[i].value)
-            {
-                bestCells.insert(bestCells.begin() + i, cellPlayed);
-                bestCells.pop_back();
-                break;
-            }
-        }
+        agents[iAgent].playARound();
     }
-
-    m_bestCells[m_round] = bestCells;
 }
 
 const AgentType &Agent::getAgentType() const
 {
     return m_ratingStrategy.getAgentType();
 }
+
+const BestCells &Agent::getBestCells() const
+{
+    return m_bestCells;
+}
+
 std::vector<double> Agent::getParametersOpeningStrategy() const
 {
     return m_openingStrategy.getParameters();
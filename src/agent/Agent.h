@@ -3,12 +3,12 @@
 
 #include <vector>
 
-#include "agent/Cell.h"
+#include "agent/BestCells.h"
+#include "agent/ExplorationCache.h"
 #include "agent/OpeningStrategy.h"
 #include "agent/RatingStrategy.h"
 #include "game/Game.h"
-
-class GameAnalyzer;
+#include "game/Validation.h"
 
 /**
  * @brief An autonomous player of a `Game`.
@@ -19,9 +19,19 @@ class GameAnalyzer;
  */
 class Agent
 {
-    friend class GameAnalyzer;
-
 public:
+    /**
+     * @brief Validation policy of the moves of the agents.
+     *
+     * The agents only play valid moves, so their moves are not checked unless the project is built
+     * with `STIGMER_CHECKED_AGENTS`, e.g. when developing a new strategy.
+     */
+#ifdef STIGMER_CHECKED_AGENTS
+    using Validation = CheckedValidation;
+#else
+    using Validation = UncheckedValidation;
+#endif
+
     /**
      * @brief Build an agent that immediately joins a game.
      *
@@ -47,15 +57,48 @@ public:
     /**
      * @brief Assign the agent to a game and reset its per-game state.
      *
+     * The storage of the best cells is reused unless the game is larger than the previous ones, so that an
+     * agent can be recycled across games without reallocating. If the game was restored from a snapshot,
+     * the best cells of the rounds already played are recovered from its history, so that the agent continues
+     * the game as the agent of the same identifier would have.
+     *
+     * The agents of a game that share an `ExplorationCache` compute the probabilities of exploring the cells
+     * once per round for each set of exploration parameters, instead of once per round and per agent. The
+     * cells they choose are the same as without the cache.
+     *
+     * @param pGame Pointer to the game the agent will play. Must not be null.
+     * @param explorationCache The cache of the exploration distributions of the game, or null for none.
+     * @throws std::invalid_argument If the cache is attached to another game.
+     */
+    void assignToGame(Game *pGame, ExplorationCache *explorationCache = nullptr);
+
+    /**
+     * @brief Assign the agent to a game with a new rating strategy and reset its per-game state.
+     *
      * @param pGame Pointer to the game the agent will play. Must not be null.
+     * @param ratingStrategy Strategy used to choose how many stars to give.
+     * @param explorationCache The cache of the exploration distributions of the game, or null for none.
+     * @throws std::invalid_argument If the cache is attached to another game.
      */
-    void assignToGame(Game *pGame);
+    void assignToGame(Game *pGame, const RatingStrategy &ratingStrategy, ExplorationCache *explorationCache = nullptr);
 
     /**
      * @brief Play a full round: open a cell and rate it, once per turn, then update the best cells.
      */
     void playARound();
 
+    /**
+     * @brief Make all the agents of a game play a full round, concurrently on the OpenMP threads.
+     *
+     * Each agent only writes into its own slot of the game, and the last agent to finish changes the round,
+     * so that the colors seen by the agents are those of the previous round, as when they play one after
+     * the other. This is meant for games with many players, where the games alone do not give enough
+     * parallelism; with a single thread, the agents play in the same order as with `playARound`.
+     *
+     * @param agents The agents, which must all be assigned to the same game.
+     */
+    static void playARoundInParallel(std::vector<Agent> &agents);
+
     /**
      * @brief Get the agent type (defined by the rating strategy).
      *
@@ -63,6 +106,13 @@ public:
      */
     const AgentType &getAgentType() const;
 
+    /**
+     * @brief Get the best cells opened by the agent during each round, sorted by decreasing value.
+     *
+     * @return A reference to the best cells, indexed by round then by turn.
+     */
+    const BestCells &getBestCells() const;
+
     /**
      * @brief Get the parameters of the opening strategy.
      *
@@ -79,23 +129,23 @@ public:
 
 private:
     /**
-     * @brief Update the top-`m_numberOfTurns` best cells opened during the current round.
+     * @brief Play a full round, scoring the turns with the policy of the rule of the game.
      *
-     * @param cellsPlayed The cells opened during the round.
+     * @tparam RulePolicy The scoring policy of the rule of the game, see `visitRule`.
      */
-    void updateBestCells(const std::vector<Cell> &cellsPlayed);
+    template <typename RulePolicy>
+    void playARoundWithRule();
 
     // Game variables
     Game *mp_Game;
     int m_iAgent;
     int m_numberOfTurns;
-    int m_numberOfCells;
     // Strategy variables
     OpeningStrategy m_openingStrategy;
     RatingStrategy m_ratingStrategy;
     //
     int m_round;
-    std::vector<std::vector<Cell>> m_bestCells;
+    BestCells m_bestCells;
 };
 
 #endif
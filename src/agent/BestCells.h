@@ -0,0 +1,152 @@
+#ifndef BEST_CELLS_H
+#define BEST_CELLS_H
+
+#include <algorithm> // std::fill, std::move_backward
+#include <cstddef>   // std::size_t
+#include <vector>
+
+#include "agent/Cell.h"
+#include "game/GameHistory.h"
+
+/**
+ * @brief The best cells opened by a player during each round of a game.
+ *
+ * The best cells of a round are the `numberOfTurns` cells of highest value opened during the round, sorted by
+ * decreasing value, the first opened first among equals, and padded with `{-1, -1}`. The cells of all the
+ * rounds are stored contiguously, round after round, in storage that is only reallocated when the games
+ * grow, so that the best cells are recorded without any allocation.
+ */
+class BestCells
+{
+public:
+    /**
+     * @brief Read-only view of the best cells of a round.
+     */
+    class RoundView
+    {
+    public:
+        RoundView(const Cell *cells, int size) : mp_cells{cells}, m_size{size} {}
+
+        /** @brief Number of best cells, which is the number of turns. */
+        [[nodiscard]] int size() const { return m_size; }
+        /** @brief The `i`-th best cell. */
+        [[nodiscard]] const Cell &operator[](int i) const { return mp_cells[i]; }
+        [[nodiscard]] const Cell *begin() const { return mp_cells; }
+        [[nodiscard]] const Cell *end() const { return mp_cells + m_size; }
+
+    private:
+        const Cell *mp_cells;
+        int m_size;
+    };
+
+    BestCells() = default;
+
+    /**
+     * @brief Build the best cells of a game that has not started.
+     *
+     * @param numberOfRounds The number of rounds of the game.
+     * @param numberOfTurns The number of turns of a round.
+     */
+    BestCells(int numberOfRounds, int numberOfTurns) { reset(numberOfRounds, numberOfTurns); }
+
+    /**
+     * @brief Forget the best cells, before a new game of the given dimensions.
+     *
+     * @param numberOfRounds The number of rounds of the game.
+     * @param numberOfTurns The number of turns of a round.
+     */
+    void reset(int numberOfRounds, int numberOfTurns)
+    {
+        m_numberOfRounds = numberOfRounds;
+        m_numberOfTurns = numberOfTurns;
+        m_cells.assign(static_cast<std::size_t>(numberOfRounds) * numberOfTurns, Cell{-1, -1});
+    }
+
+    [[nodiscard]] int getNumberOfRounds() const { return m_numberOfRounds; }
+
+    [[nodiscard]] int getNumberOfTurns() const { return m_numberOfTurns; }
+
+    /**
+     * @brief Get the best cells of a round.
+     *
+     * @param iRound The index of the round.
+     * @return A view of the best cells of the round, valid until the next reset.
+     */
+    [[nodiscard]] RoundView operator[](int iRound) const
+    {
+        return {&m_cells[static_cast<std::size_t>(iRound) * m_numberOfTurns], m_numberOfTurns};
+    }
+
+    /**
+     * @brief Replace the best cells of a round by the best of the cells played during it.
+     *
+     * @param iRound The index of the round.
+     * @param cellsPlayed The cells played during the round.
+     */
+    void record(int iRound, const GameHistory::RoundView &cellsPlayed)
+    {
+        Cell *first{&m_cells[static_cast<std::size_t>(iRound) * m_numberOfTurns]};
+        Cell *last{first + m_numberOfTurns};
+        std::fill(first, last, Cell{-1, -1});
+        for (int iTurn{0}; iTurn < cellsPlayed.size(); ++iTurn)
+        {
+            insert(first, last, Cell{cellsPlayed.getCell(iTurn), cellsPlayed.getValue(iTurn)});
+        }
+    }
+
+    /**
+     * @brief Insert a cell into a range of best cells sorted by decreasing value, after the cells of the same
+     * value, the last cell of the range being dropped. Nothing is inserted if the value of the cell is not above
+     * that of the last cell.
+     *
+     * @param first The first of the best cells.
+     * @param last The end of the best cells.
+     * @param cell The cell to insert.
+     */
+    template <typename Iterator>
+    static void insert(Iterator first, Iterator last, const Cell &cell)
+    {
+        for (Iterator it{first}; it != last; ++it)
+        {
+            if (cell.value > it->value)
+            {
+                std::move_backward(it, last - 1, last);
+                *it = cell;
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Insert a cell as `insert` does, unless the cell is already among the best cells.
+     *
+     * @param first The first of the best cells.
+     * @param last The end of the best cells.
+     * @param cell The cell to insert.
+     */
+    template <typename Iterator>
+    static void insertUnique(Iterator first, Iterator last, const Cell &cell)
+    {
+        for (Iterator it{first}; it != last; ++it)
+        {
+            if (cell.index == it->index)
+            {
+                return;
+            }
+            if (cell.value > it->value)
+            {
+                std::move_backward(it, last - 1, last);
+                *it = cell;
+                return;
+            }
+        }
+    }
+
+private:
+    int m_numberOfRounds{0};
+    int m_numberOfTurns{0};
+    // Best cells of each round, by round then by turn
+    std::vector<Cell> m_cells;
+};
+
+#endif
@@ -0,0 +1,72 @@
+#include <memory> // std::make_unique
+#include <mutex>  // std::lock_guard, std::mutex
+#include <vector>
+
+#include "agent/ExplorationCache.h"
+#include "agent/ExplorationDistribution.h"
+#include "game/ColorView.h"
+#include "game/Game.h"
+#include "math/PowerTable.h"
+
+ExplorationCache::ExplorationCache(Game &game)
+    : m_game{game},
+      m_mutex{},
+      m_entries{}
+{
+    m_game.addObserver(*this);
+}
+
+ExplorationCache::~ExplorationCache()
+{
+    m_game.removeObserver(*this);
+}
+
+const ExplorationDistribution &ExplorationCache::getDistribution(const std::vector<double> &parametersExploration,
+                                                                 int round, const ColorView &colors,
+                                                                 const myMath::PowerTable *powersOfStars)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+
+    // The entries of the parameters that are not used anymore are recycled
+    Entry *pEntry{nullptr};
+    for (const auto &entry : m_entries)
+    {
+        if (entry->parametersExploration == parametersExploration)
+        {
+            pEntry = entry.get();
+            break;
+        }
+        if (entry->round < 0 && !pEntry)
+        {
+            pEntry = entry.get();
+        }
+    }
+    if (!pEntry)
+    {
+        m_entries.push_back(std::make_unique<Entry>());
+        pEntry = m_entries.back().get();
+        pEntry->round = -1;
+    }
+
+    if (pEntry->round != round || pEntry->parametersExploration != parametersExploration)
+    {
+        pEntry->parametersExploration = parametersExploration;
+        pEntry->round = round;
+        pEntry->distribution.update(parametersExploration, colors, powersOfStars);
+    }
+    return pEntry->distribution;
+}
+
+const Game &ExplorationCache::getGame() const
+{
+    return m_game;
+}
+
+void ExplorationCache::onGameReset(const Game & /* game */)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &entry : m_entries)
+    {
+        entry->round = -1;
+    }
+}
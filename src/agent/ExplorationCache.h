@@ -0,0 +1,78 @@
+#ifndef EXPLORATION_CACHE_H
+#define EXPLORATION_CACHE_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "agent/ExplorationDistribution.h"
+#include "game/ColorView.h"
+#include "game/Game.h"
+#include "game/GameObserver.h"
+#include "math/PowerTable.h"
+
+/**
+ * @brief The exploration distributions of the current round of a game, shared by its agents.
+ *
+ * The colors are the same for all the agents of a game during a round, so that the agents with the same
+ * exploration parameters explore the map with the same distribution. The first of them to play a round
+ * computes the distribution, and the others reuse it, read-only, instead of computing it again, see
+ * `Agent::assignToGame`. The distributions are kept for each set of parameters met in the game, and their
+ * storage is reused from round to round and from game to game.
+ *
+ * The cache observes its game to forget the distributions when the game is reset or restored from a
+ * snapshot. The distribution of a round is computed at the first request of the round, under a lock, so that
+ * the agents may play a round concurrently, see `Agent::playARoundInParallel`; it is not modified before the
+ * next round, once all the agents have played.
+ */
+class ExplorationCache : public GameObserver
+{
+public:
+    /**
+     * @brief Build an empty cache, attached to a game.
+     *
+     * @param game The game, which must outlive the cache.
+     */
+    explicit ExplorationCache(Game &game);
+
+    ~ExplorationCache() override;
+
+    ExplorationCache(const ExplorationCache &) = delete;
+
+    ExplorationCache &operator=(const ExplorationCache &) = delete;
+
+    /**
+     * @brief Get the exploration distribution of a round, computing it if it is the first request of the round
+     * for these parameters.
+     *
+     * @param parametersExploration The exploration parameters of the agent.
+     * @param round The current round of the game.
+     * @param colors The colors of the game.
+     * @param powersOfStars The powers of the numbers of stars for the exponent of the parameters, if the agent
+     *        has them, see `ExplorationDistribution::update`.
+     * @return A reference to the distribution, valid until the next round.
+     */
+    const ExplorationDistribution &getDistribution(const std::vector<double> &parametersExploration, int round,
+                                                   const ColorView &colors,
+                                                   const myMath::PowerTable *powersOfStars = nullptr);
+
+    /** @brief The game the cache is attached to. */
+    [[nodiscard]] const Game &getGame() const;
+
+    void onGameReset(const Game &game) override;
+
+private:
+    struct Entry
+    {
+        std::vector<double> parametersExploration;
+        int round;
+        ExplorationDistribution distribution;
+    };
+
+    Game &m_game;
+    std::mutex m_mutex;
+    // The entries are not moved when new ones are added, so that the references given stay valid
+    std::vector<std::unique_ptr<Entry>> m_entries;
+};
+
+#endif
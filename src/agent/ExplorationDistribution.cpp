@@ -0,0 +1,203 @@
+#include <algorithm> // std::binary_search, std::fill, std::lower_bound, std::max, std::min, std::upper_bound
+#include <numeric>   // std::accumulate
+#include <vector>
+
+#include "agent/ExplorationDistribution.h"
+#include "game/ColorView.h"
+#include "math/PowerTable.h"
+#include "math/VectorMath.h"
+#include "random/myRandom.h"
+
+void ExplorationDistribution::update(const std::vector<double> &parametersExploration, const ColorView &colors,
+                                     const myMath::PowerTable *powersOfStars)
+{
+    // A table of another exponent cannot be used
+    if (powersOfStars && powersOfStars->getExponent() != parametersExploration[1])
+    {
+        powersOfStars = nullptr;
+    }
+
+    m_isSparse = colors.size() >= minNumberOfCellsForSparseExploration && parametersExploration[1] > 0.;
+    if (m_isSparse)
+    {
+        updateSparseWeights(parametersExploration, colors, powersOfStars);
+    }
+    else
+    {
+        updateProbabilities(parametersExploration, colors, powersOfStars);
+        m_sampler.assign(m_probabilities);
+    }
+}
+
+int ExplorationDistribution::draw(const ColorView &colors, const std::vector<int> &excludedCells) const
+{
+    if (m_isSparse)
+    {
+        return drawSparsely(colors, excludedCells);
+    }
+    return static_cast<int>(m_sampler.draw(excludedCells));
+}
+
+void ExplorationDistribution::updateProbabilities(const std::vector<double> &parametersExploration,
+                                                  const ColorView &colors, const myMath::PowerTable *powersOfStars)
+{
+    const int numberOfCells{colors.size()};
+
+    if (colors.isEmpty())
+    {
+        m_probabilities.assign(numberOfCells, 1. / numberOfCells);
+    }
+    else
+    {
+        // The powers are computed in place to avoid allocating a temporary vector every round
+        computePowersOfColors(parametersExploration[1], colors, powersOfStars, nullptr, m_probabilities);
+        const double sumPowers{std::accumulate(m_probabilities.begin(), m_probabilities.end(), 0.)};
+
+        for (int iCell{0}; iCell < numberOfCells; ++iCell)
+        {
+            m_probabilities[iCell] = parametersExploration[0] / numberOfCells +
+                                     (1 - parametersExploration[0]) * m_probabilities[iCell] / sumPowers;
+        }
+    }
+}
+
+void ExplorationDistribution::updateSparseWeights(const std::vector<double> &parametersExploration,
+                                                  const ColorView &colors, const myMath::PowerTable *powersOfStars)
+{
+    const int numberOfCells{colors.size()};
+    const std::vector<int> &occupiedCells{colors.getOccupiedCells()};
+
+    m_sparseCumulatives.resize(occupiedCells.size());
+    if (colors.isEmpty())
+    {
+        m_uniformWeight = 1. / numberOfCells;
+        std::fill(m_sparseCumulatives.begin(), m_sparseCumulatives.end(), 0.);
+    }
+    else
+    {
+        // Same weights as `updateProbabilities`, the powers of the empty cells being 0
+        computePowersOfColors(parametersExploration[1], colors, powersOfStars, &occupiedCells, m_sparseCumulatives);
+        double sumPowers{0.};
+        for (double &cumulative : m_sparseCumulatives)
+        {
+            sumPowers += cumulative;
+            cumulative = sumPowers;
+        }
+        for (double &cumulative : m_sparseCumulatives)
+        {
+            cumulative *= (1 - parametersExploration[0]) / sumPowers;
+        }
+        m_uniformWeight = parametersExploration[0] / numberOfCells;
+    }
+}
+
+void ExplorationDistribution::computePowersOfColors(double exponent, const ColorView &colors,
+                                                    const myMath::PowerTable *powersOfStars,
+                                                    const std::vector<int> *cells, std::vector<double> &powers)
+{
+    const int numberOfCells{cells ? static_cast<int>(cells->size()) : colors.size()};
+    powers.resize(numberOfCells);
+    if (powersOfStars && colors.hasIntegerStars())
+    {
+        const std::vector<double> &stars{colors.getStars()};
+        for (int i{0}; i < numberOfCells; ++i)
+        {
+            powers[i] = (*powersOfStars)(static_cast<int>(stars[cells ? (*cells)[i] : i]));
+        }
+    }
+    else
+    {
+        for (int i{0}; i < numberOfCells; ++i)
+        {
+            powers[i] = colors[cells ? (*cells)[i] : i];
+        }
+        myMath::pow(powers.data(), exponent, powers.data(), powers.size());
+    }
+}
+
+int ExplorationDistribution::drawSparsely(const ColorView &colors, const std::vector<int> &excludedCells) const
+{
+    // Position of a cell among the occupied cells, or -1 if the cell holds no star
+    const std::vector<int> &occupiedCells{colors.getOccupiedCells()};
+    auto findOccupied = [&occupiedCells](int iCell)
+    {
+        const auto it{std::lower_bound(occupiedCells.begin(), occupiedCells.end(), iCell)};
+        return it != occupiedCells.end() && *it == iCell ? static_cast<int>(it - occupiedCells.begin()) : -1;
+    };
+    auto cumulativeBefore = [this](int iOccupied)
+    { return iOccupied == 0 ? 0. : m_sparseCumulatives[iOccupied - 1]; };
+
+    // The weight of a cell is a uniform background plus the part given by its color, which is 0 for most cells
+    const int numberOfAllowedCells{colors.size() - static_cast<int>(excludedCells.size())};
+    const double uniformTotal{m_uniformWeight * numberOfAllowedCells};
+    double sparseTotal{m_sparseCumulatives.empty() ? 0. : m_sparseCumulatives.back()};
+    for (const int iCell : excludedCells)
+    {
+        const int iOccupied{findOccupied(iCell)};
+        if (iOccupied >= 0)
+        {
+            sparseTotal -= m_sparseCumulatives[iOccupied] - cumulativeBefore(iOccupied);
+        }
+    }
+    double target{myRandom::rand(uniformTotal + std::max(sparseTotal, 0.))};
+
+    // Uniform part: a fraction of the allowed cells is mapped to the cells by skipping the excluded ones
+    auto chooseUniformly = [&excludedCells, numberOfAllowedCells](double fraction)
+    {
+        int iCell{std::min(static_cast<int>(fraction * numberOfAllowedCells), numberOfAllowedCells - 1)};
+        for (const int iExcluded : excludedCells)
+        {
+            if (iExcluded > iCell)
+            {
+                break;
+            }
+            ++iCell;
+        }
+        return iCell;
+    };
+    if (target < uniformTotal || m_sparseCumulatives.empty())
+    {
+        return chooseUniformly(uniformTotal > 0. ? target / uniformTotal : 0.);
+    }
+
+    // Part given by the colors: the draw is mapped to the cumulative weights of the occupied cells by
+    // skipping the weights of the excluded cells that come before it
+    target -= uniformTotal;
+    for (const int iCell : excludedCells)
+    {
+        const int iOccupied{findOccupied(iCell)};
+        if (iOccupied >= 0)
+        {
+            if (target < cumulativeBefore(iOccupied))
+            {
+                break;
+            }
+            target += m_sparseCumulatives[iOccupied] - cumulativeBefore(iOccupied);
+        }
+    }
+    const int iChosen{static_cast<int>(
+        std::upper_bound(m_sparseCumulatives.begin(), m_sparseCumulatives.end() - 1, target) -
+        m_sparseCumulatives.begin())};
+
+    // Rounding errors may land the draw on an excluded cell, in which case the nearest allowed one is taken
+    auto isAllowed = [this, &excludedCells, &occupiedCells, &cumulativeBefore](int iOccupied)
+    {
+        return m_sparseCumulatives[iOccupied] > cumulativeBefore(iOccupied) &&
+               !std::binary_search(excludedCells.begin(), excludedCells.end(), occupiedCells[iOccupied]);
+    };
+    for (int iOccupied{iChosen}; iOccupied >= 0; --iOccupied)
+    {
+        if (isAllowed(iOccupied))
+        {
+            return occupiedCells[iOccupied];
+        }
+    }
+    for (int iOccupied{iChosen + 1}; iOccupied < occupiedCells.size(); ++iOccupied)
+    {
+        if (isAllowed(iOccupied))
+        {
+            return occupiedCells[iOccupied];
+        }
+    }
+    return chooseUniformly(myRandom::rand());
+}
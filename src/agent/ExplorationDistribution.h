@@ -0,0 +1,107 @@
+#ifndef EXPLORATION_DISTRIBUTION_H
+#define EXPLORATION_DISTRIBUTION_H
+
+#include <vector>
+
+#include "game/ColorView.h"
+#include "math/PowerTable.h"
+#include "random/CumulativeSampler.h"
+
+/**
+ * @brief The probabilities of exploring each cell of a map during a round, and the sampler of the explored
+ * cells.
+ *
+ * The probability of exploring a cell is a mixture of a uniform probability and of a probability
+ * proportional to a power of the color of the cell, both given by the exploration parameters of an
+ * `OpeningStrategy`. The distribution only depends on these parameters and on the colors of the round, so
+ * that it is computed once per round, and may be shared by all the agents of a game with the same parameters,
+ * see `ExplorationCache`.
+ *
+ * In the games without evaporation, the stars of the cells are integers and the colors are proportional to
+ * them, so that the powers of the colors are proportional to the powers of the stars, the sum of the stars
+ * cancelling out once the probabilities are normalized. The powers of the stars are then read from a table
+ * computed once per exponent, instead of computing the power of every color at every round.
+ */
+class ExplorationDistribution
+{
+public:
+    /**
+     * @brief Number of cells from which the maps are explored through their occupied cells only.
+     *
+     * On such maps, the probability of exploring a cell is drawn as a uniform background plus a correction
+     * on the cells holding stars, so that the cost of a turn depends on the number of occupied cells rather
+     * than on the size of the map. The random draws differ from the dense ones, but follow the same
+     * distribution. The 225-cell map of the experiment keeps the dense draws.
+     */
+    static constexpr int minNumberOfCellsForSparseExploration{450};
+
+    /**
+     * @brief Compute the distribution of the explored cells for the colors of a round.
+     *
+     * If there is no rating in the map, then all cells have the same probability of being explored.
+     *
+     * @param parametersExploration The weight of the uniform probability, then the exponent of the colors.
+     * @param colors The percentage of ratings in each cell.
+     * @param powersOfStars The powers of the numbers of stars, used when the stars of `colors` are integers and
+     *        the exponent of the table is that of the parameters, or null to compute the powers of the colors.
+     */
+    void update(const std::vector<double> &parametersExploration, const ColorView &colors,
+                const myMath::PowerTable *powersOfStars = nullptr);
+
+    /**
+     * @brief Choose a cell by exploring.
+     *
+     * The excluded cells are skipped without copying the probabilities, which gives the same draws as setting
+     * their probability to 0.
+     *
+     * @param colors The colors the distribution was computed from.
+     * @param excludedCells The cells that cannot be explored, sorted by increasing index and without
+     *        duplicates.
+     * @return The index of the cell chosen by exploring.
+     */
+    [[nodiscard]] int draw(const ColorView &colors, const std::vector<int> &excludedCells) const;
+
+private:
+    bool m_isSparse{false};
+    // Dense exploration
+    std::vector<double> m_probabilities;
+    myRandom::CumulativeSampler m_sampler;
+    // Sparse exploration, see `minNumberOfCellsForSparseExploration`
+    double m_uniformWeight{0.};
+    std::vector<double> m_sparseCumulatives;
+
+    /**
+     * @brief Compute the probability of exploring each cell, and the sampler of these probabilities.
+     */
+    void updateProbabilities(const std::vector<double> &parametersExploration, const ColorView &colors,
+                             const myMath::PowerTable *powersOfStars);
+
+    /**
+     * @brief Compute the uniform exploration weight of every cell and the cumulative extra weights of the
+     * occupied cells, which together give the same probabilities as `updateProbabilities`.
+     */
+    void updateSparseWeights(const std::vector<double> &parametersExploration, const ColorView &colors,
+                             const myMath::PowerTable *powersOfStars);
+
+    /**
+     * @brief Compute the powers of the colors of some cells, up to a common factor.
+     *
+     * @param exponent The exponent of the colors.
+     * @param colors The colors of the cells.
+     * @param powersOfStars The powers of the numbers of stars, see `update`.
+     * @param cells The indices of the cells, or null for all the cells.
+     * @param powers Set to the powers of the colors of the cells, or of their stars.
+     */
+    static void computePowersOfColors(double exponent, const ColorView &colors,
+                                      const myMath::PowerTable *powersOfStars, const std::vector<int> *cells,
+                                      std::vector<double> &powers);
+
+    /**
+     * @brief Choose a cell by exploring, from the weights computed by `updateSparseWeights`.
+     *
+     * The cost depends on the number of occupied cells and not on the size of the map.
+     */
+    [[nodiscard]] int drawSparsely(const ColorView &colors, const std::vector<int> &excludedCells) const;
+};
+
+#endif
@@ -1,65 +1,53 @@
-#include <algorithm> // std::all_of, std::any_of, std::transform
-#include <cmath>     // std::pow
-#include <numeric>   // std::accumulate
+#include <algorithm> // std::sort, std::unique
+#include <stdexcept> // std::invalid_argument
 #include <vector>
 
-#include "agent/Cell.h"
+#include "agent/BestCells.h"
+#include "agent/ExplorationCache.h"
+#include "agent/ExplorationDistribution.h"
 #include "agent/OpeningStrategy.h"
+#include "game/ColorView.h"
+#include "game/GameHistory.h"
+#include "math/PowerTable.h"
 #include "random/myRandom.h"
 
 OpeningStrategy::OpeningStrategy(const std::vector<double> &parametersExploration,
                                  const std::vector<std::vector<double>> &parametersReplayCell)
     : m_parametersExploration{parametersExploration},
-      m_parametersReplayCell{parametersReplayCell},
-      m_exploringProbabilities{},
+      m_parametersReplayCell{toReplayParameters(parametersReplayCell)},
+      mp_powersOfStars{myMath::PowerTable::getShared(parametersExploration[1], maxTabulatedStars)},
+      m_exploration{},
+      mp_explorationCache{nullptr},
+      mp_sharedExploration{nullptr},
+      m_excludedCells{},
       m_round{-1}
 {
 }
 
-// ! Only works for 2 parameters for the exploration and 3 x 2 parameters for the replay cell
 OpeningStrategy::OpeningStrategy(const std::vector<double> &parametersOpenings)
-    : OpeningStrategy(std::vector<double>(parametersOpenings.begin(), parametersOpenings.begin() + 2),
-                      to2d(std::vector<double>(parametersOpenings.begin() + 2, parametersOpenings.end()), 3))
+    : OpeningStrategy(splitParametersExploration(parametersOpenings), splitParametersReplay(parametersOpenings))
 {
 }
 
-void OpeningStrategy::updateExploringProbabilities(const std::vector<double> &colors)
-{
-    const int numberOfCells{static_cast<int>(colors.size())};
-
-    const bool noRatings{std::all_of(colors.begin(), colors.end(), [](double x)
-                                     { return x == 0.; })};
-    if (noRatings)
-    {
-        m_exploringProbabilities = std::vector<double>(numberOfCells, 1. / numberOfCells);
-    }
-    else
-    {
-        std::vector<double> powers(numberOfCells);
-        std::transform(colors.begin(), colors.end(), powers.begin(),
-                       [alpha = m_parametersExploration[1]](double x)
-                       { return std::pow(x, alpha); });
-        const double sumPowers{std::accumulate(powers.begin(), powers.end(), 0.)};
-
-        for (int iCell{0}; iCell < numberOfCells; ++iCell)
-        {
-            m_exploringProbabilities[iCell] = m_parametersExploration[0] / numberOfCells +
-                                              (1 - m_parametersExploration[0]) * powers[iCell] / sumPowers;
-        }
-    }
-}
-
-int OpeningStrategy::chooseCell(int round, const std::vector<double> &colors, const std::vector<std::vector<Cell>> &bestCells,
-                                const std::vector<Cell> &cellsPlayed)
+int OpeningStrategy::chooseCell(int round, const ColorView &colors, const BestCells &bestCells,
+                                const GameHistory::RoundView &cellsPlayed)
 {
     // If the round has changed, then the probabilities of exploring each cell must be updated
     if (round != m_round)
     {
         m_round = round;
-        updateExploringProbabilities(colors);
+        if (mp_explorationCache)
+        {
+            mp_sharedExploration = &mp_explorationCache->getDistribution(m_parametersExploration, round, colors,
+                                                                         mp_powersOfStars.get());
+        }
+        else
+        {
+            m_exploration.update(m_parametersExploration, colors, mp_powersOfStars.get());
+        }
     }
 
-    const int iTurn = cellsPlayed.size();
+    const int iTurn{cellsPlayed.size()};
     if (round != 0)
     {
         if (shouldReplayCell(bestCells[round - 1][iTurn].value, iTurn))
@@ -67,56 +55,93 @@ int OpeningStrategy::chooseCell(int round, const std::vector<double> &colors, co
             return bestCells[round - 1][iTurn].index;
         }
     }
-    return chooseACellByExploring(round, m_exploringProbabilities, bestCells, cellsPlayed);
+    updateExcludedCells(round, bestCells, cellsPlayed);
+    return (mp_explorationCache ? *mp_sharedExploration : m_exploration).draw(colors, m_excludedCells);
 }
 
 bool OpeningStrategy::shouldReplayCell(int value, int iTurn) const
 {
-    return myRandom::rand() < m_parametersReplayCell[iTurn][1] * (value - m_parametersReplayCell[iTurn][0]) / 99.;
+    const ReplayParameters &parameters{m_parametersReplayCell[iTurn]};
+    return myRandom::rand() < parameters.slope * (value - parameters.minValue) / 99.;
 }
 
-int OpeningStrategy::chooseACellByExploring(int round, const std::vector<double> &exploringProbabilities,
-                                            const std::vector<std::vector<Cell>> &bestCells,
-                                            const std::vector<Cell> &cellsPlayed)
+void OpeningStrategy::updateExcludedCells(int round, const BestCells &bestCells,
+                                          const GameHistory::RoundView &cellsPlayed)
 {
-    // If the cell has already been played during the round or if it is one of the best cells, then the probability of
-    // exploring it is set to 0.
-    std::vector<double> exProba{exploringProbabilities};
+    m_excludedCells.clear();
     if (round > 0)
     {
-        for (auto &cell : bestCells[round - 1])
+        for (const auto &cell : bestCells[round - 1])
         {
-            exProba[cell.index] = 0;
+            m_excludedCells.push_back(cell.index);
         }
     }
-    for (auto &cell : cellsPlayed)
+    for (int iTurn{0}; iTurn < cellsPlayed.size(); ++iTurn)
     {
-        exProba[cell.index] = 0;
+        m_excludedCells.push_back(cellsPlayed.getCell(iTurn));
     }
-    return myRandom::randIndexWeighted(exProba);
+    std::sort(m_excludedCells.begin(), m_excludedCells.end());
+    m_excludedCells.erase(std::unique(m_excludedCells.begin(), m_excludedCells.end()), m_excludedCells.end());
 }
 
-std::vector<std::vector<double>> OpeningStrategy::to2d(const std::vector<double> &vector1d, const int nRows)
+void OpeningStrategy::reset(ExplorationCache *explorationCache)
 {
-    if (vector1d.size() % nRows != 0)
+    m_round = -1;
+    mp_explorationCache = explorationCache;
+    mp_sharedExploration = nullptr;
+}
+
+std::vector<OpeningStrategy::ReplayParameters>
+OpeningStrategy::toReplayParameters(const std::vector<std::vector<double>> &parametersReplayCell)
+{
+    std::vector<ReplayParameters> parameters;
+    parameters.reserve(parametersReplayCell.size());
+    for (const auto &parametersTurn : parametersReplayCell)
     {
-        throw std::runtime_error("AgentOpeningStrategy::to_2d: The vector size is not a multiple of the number of rows.");
+        if (parametersTurn.size() != numberOfParametersReplay)
+        {
+            throw std::invalid_argument("OpeningStrategy: The replay of a turn needs 2 parameters.");
+        }
+        parameters.push_back({parametersTurn[0], parametersTurn[1]});
     }
+    return parameters;
+}
 
-    std::vector<std::vector<double>> vector2d(nRows);
-    for (int iRow{0}; iRow < nRows; ++iRow)
+void OpeningStrategy::checkNumberOfParameters(const std::vector<double> &parametersOpenings)
+{
+    const int numberOfParametersReplayCell{static_cast<int>(parametersOpenings.size()) - numberOfParametersExploration};
+    if (numberOfParametersReplayCell < 0 || numberOfParametersReplayCell % numberOfParametersReplay != 0)
+    {
+        throw std::invalid_argument("OpeningStrategy: The parameters must be the 2 parameters of the exploration "
+                                    "followed by 2 parameters for each turn.");
+    }
+}
+
+std::vector<double> OpeningStrategy::splitParametersExploration(const std::vector<double> &parametersOpenings)
+{
+    checkNumberOfParameters(parametersOpenings);
+    return {parametersOpenings.begin(), parametersOpenings.begin() + numberOfParametersExploration};
+}
+
+std::vector<std::vector<double>> OpeningStrategy::splitParametersReplay(const std::vector<double> &parametersOpenings)
+{
+    checkNumberOfParameters(parametersOpenings);
+    std::vector<std::vector<double>> parametersReplayCell;
+    for (auto it{parametersOpenings.begin() + numberOfParametersExploration}; it != parametersOpenings.end();
+         it += numberOfParametersReplay)
     {
-        vector2d[iRow] = std::vector<double>(vector1d.begin() + iRow * 2, vector1d.begin() + (iRow + 1) * 2);
+        parametersReplayCell.emplace_back(it, it + numberOfParametersReplay);
     }
-    return vector2d;
+    return parametersReplayCell;
 }
 
 std::vector<double> OpeningStrategy::getParameters() const
 {
     std::vector<double> parameters{m_parametersExploration};
-    for (const auto &row : m_parametersReplayCell)
+    for (const auto &parametersTurn : m_parametersReplayCell)
     {
-        parameters.insert(parameters.end(), row.begin(), row.end());
+        parameters.push_back(parametersTurn.minValue);
+        parameters.push_back(parametersTurn.slope);
     }
     return parameters;
 }
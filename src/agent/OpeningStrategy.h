@@ -1,16 +1,37 @@
 #ifndef OPENING_STRATEGY_H
 #define OPENING_STRATEGY_H
 
+#include <memory>
 #include <vector>
 
-#include "agent/Cell.h"
+#include "agent/BestCells.h"
+#include "agent/ExplorationCache.h"
+#include "agent/ExplorationDistribution.h"
+#include "game/ColorView.h"
+#include "game/GameHistory.h"
+#include "math/PowerTable.h"
 
 class OpeningStrategy
 {
 public:
+    /**
+     * @brief Build an opening strategy.
+     *
+     * @param parametersExploration The parameters of the exploration, see `ExplorationDistribution`.
+     * @param parametersReplayCell The two parameters of the replay of the best cell of each turn: the value
+     *        below which the cell is never replayed, and the slope of the probability of replaying it.
+     * @throws std::invalid_argument If a turn does not have two parameters.
+     */
     OpeningStrategy(const std::vector<double> &parametersExploration,
                     const std::vector<std::vector<double>> &parametersReplayCell);
 
+    /**
+     * @brief Build an opening strategy from a flat parameter vector: the 2 parameters of the exploration, then
+     * the 2 parameters of the replay of each turn.
+     *
+     * @param parametersOpenings The flat vector of parameters, of even size.
+     * @throws std::invalid_argument If the size of the vector is odd or below 2.
+     */
     OpeningStrategy(const std::vector<double> &parametersOpenings);
 
     /**
@@ -22,25 +43,50 @@ public:
      * @param cellsPlayed The cells already played during the current round.
      * @return The index of the cell chosen.
      */
-    int chooseCell(int round, const std::vector<double> &colors, const std::vector<std::vector<Cell>> &bestCells,
-                   const std::vector<Cell> &cellsPlayed);
+    int chooseCell(int round, const ColorView &colors, const BestCells &bestCells,
+                   const GameHistory::RoundView &cellsPlayed);
+
+    /**
+     * @brief Forget the probabilities cached for the current round, before starting a new game.
+     *
+     * @param explorationCache The cache of the exploration distributions of the new game, shared with the
+     *        other agents of the game, or null to compute the distributions for this strategy only.
+     */
+    void reset(ExplorationCache *explorationCache = nullptr);
 
     std::vector<double> getParameters() const;
 
 private:
-    std::vector<double> m_parametersExploration;
-    std::vector<std::vector<double>> m_parametersReplayCell;
-    std::vector<double> m_exploringProbabilities;
-    int m_round;
-
     /**
-     * @brief Compute the probability of exploring each cell.
-     *
-     * If there is no rating in the map, then all cells have the same probability of being explored.
-     *
-     * @param colors The percentage of ratings in each cell.
+     * @brief Parameters of the replay of the best cell of a turn of the previous round.
      */
-    void updateExploringProbabilities(const std::vector<double> &colors);
+    struct ReplayParameters
+    {
+        // Value below which the cell is never replayed
+        double minValue;
+        // Increase of the probability of replaying the cell per 99 points of value above `minValue`
+        double slope;
+    };
+
+    // Number of parameters of the exploration and of the replay of a turn, in the flat vectors of parameters
+    static constexpr int numberOfParametersExploration{2};
+    static constexpr int numberOfParametersReplay{2};
+
+    // Largest number of stars of a cell whose power is tabulated, above the 1500 stars a cell may get in the games
+    // of 5 players and 20 rounds
+    static constexpr int maxTabulatedStars{4095};
+
+    std::vector<double> m_parametersExploration;
+    std::vector<ReplayParameters> m_parametersReplayCell;
+    // Powers of the numbers of stars for the exponent of the exploration, shared by the strategies of this exponent
+    std::shared_ptr<const myMath::PowerTable> mp_powersOfStars;
+    // Distribution of the explored cells, own or shared through the cache of the game
+    ExplorationDistribution m_exploration;
+    ExplorationCache *mp_explorationCache;
+    const ExplorationDistribution *mp_sharedExploration;
+    // Cells that cannot be explored during the current turn, sorted by increasing index
+    std::vector<int> m_excludedCells;
+    int m_round;
 
     /**
      * @brief Check if the cell should be replayed.
@@ -52,28 +98,48 @@ private:
     bool shouldReplayCell(int value, int iTurn) const;
 
     /**
-     * @brief Choose a cell by exploring.
-     *
-     * Cells that have already been played during the round or that are among the best cells have their
-     * exploration probability set to 0.
+     * @brief Gather the cells that cannot be explored during the current turn into `m_excludedCells`: the
+     * cells already played during the round and the best cells of the previous round.
      *
      * @param round The current round of the game.
-     * @param exploringProbabilities The probability of exploring each cell.
      * @param bestCells The best cells played, indexed by round.
      * @param cellsPlayed The cells already played during the current round.
-     * @return The index of the cell chosen by exploring.
      */
-    static int chooseACellByExploring(int round, const std::vector<double> &exploringProbabilities,
-                                      const std::vector<std::vector<Cell>> &bestCells, const std::vector<Cell> &cellsPlayed);
+    void updateExcludedCells(int round, const BestCells &bestCells,
+                             const GameHistory::RoundView &cellsPlayed);
+
+    /**
+     * @brief Convert the parameters of the replay of each turn to their typed form.
+     *
+     * @param parametersReplayCell The parameters of each turn.
+     * @return The typed parameters of each turn.
+     */
+    static std::vector<ReplayParameters>
+    toReplayParameters(const std::vector<std::vector<double>> &parametersReplayCell);
+
+    /**
+     * @brief Check that a flat vector of parameters holds the exploration and whole turns of replay.
+     *
+     * @param parametersOpenings The flat vector of parameters of the strategy.
+     * @throws std::invalid_argument If the size of the vector is odd or below 2.
+     */
+    static void checkNumberOfParameters(const std::vector<double> &parametersOpenings);
+
+    /**
+     * @brief Get the parameters of the exploration from the flat vector of parameters.
+     *
+     * @param parametersOpenings The flat vector of parameters of the strategy.
+     * @return The parameters of the exploration.
+     */
+    static std::vector<double> splitParametersExploration(const std::vector<double> &parametersOpenings);
 
     /**
-     * @brief Convert a 1D vector to a 2D vector.
+     * @brief Split the flat vector of parameters of the replay into the parameters of each turn.
      *
-     * @param vector1d The input 1D vector. Its size must be a multiple of `nRows`.
-     * @param nRows The number of rows of the 2D vector.
-     * @return The resulting 2D vector.
+     * @param parametersOpenings The flat vector of parameters of the strategy.
+     * @return The parameters of each turn.
      */
-    static std::vector<std::vector<double>> to2d(const std::vector<double> &vector1d, const int nRows);
+    static std::vector<std::vector<double>> splitParametersReplay(const std::vector<double> &parametersOpenings);
 };
 
 #endif
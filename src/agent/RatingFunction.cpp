@@ -0,0 +1,306 @@
+#include <algorithm>   // std::max, std::min
+#include <array>
+#include <cstddef>     // std::size_t
+#include <stdexcept>   // std::invalid_argument
+#include <string>
+#include <type_traits> // std::remove_pointer_t
+#include <variant>     // std::variant_alternative_t, std::variant_size_v, std::visit
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "agent/RatingFunction.h"
+#include "math/VectorMath.h"
+
+namespace
+{
+    /**
+     * @brief Read a fixed number of parameters from an entry of the JSON of a strategy.
+     */
+    template <std::size_t N>
+    std::array<double, N> readParameters(const nlohmann::json &parameters, const char *key)
+    {
+        return parameters.at(key).get<std::array<double, N>>();
+    }
+
+    /**
+     * @brief Throw for the functions that have no flat parameters.
+     */
+    [[noreturn]] void throwNoFlatParameters(const std::string &functionType)
+    {
+        throw std::invalid_argument("The function type " + functionType + " has no flat parameters.");
+    }
+
+    /**
+     * @brief Share the rest of the probability between the ratings 1 to 4, once those of 0 and 5 are set.
+     */
+    void shareRest(std::vector<double> &probabilities)
+    {
+        const double p1234{(1. - probabilities[0] - probabilities[5]) / 4.};
+        probabilities[1] = p1234;
+        probabilities[2] = p1234;
+        probabilities[3] = p1234;
+        probabilities[4] = p1234;
+    }
+
+    double functionTanh(const std::array<double, 4> &parameters, int value)
+    {
+        return parameters[0] + parameters[1] * myMath::tanh((value - parameters[2]) / 99. * parameters[3]);
+    }
+
+    double functionLinear(const std::array<double, 2> &parameters, int value)
+    {
+        double result = parameters[0] + parameters[1] * value / 99.;
+        result = std::max(0.0, std::min(result, 1.0)); // Clip the result to the range [0, 1]
+        return result;
+    }
+
+    double functionGaussian(const std::array<double, 3> &parameters, int value)
+    {
+        const double x{(value - parameters[1]) / 99. * parameters[2]};
+        double result = parameters[0] * myMath::exp(-x * x);
+        result = std::max(0.0, std::min(result, 1.0)); // Clip the result to the range [0, 1]
+        return result;
+    }
+
+    /**
+     * @brief Build the function of the registered type named `functionType`, trying the types of
+     * `RatingFunction` from the `I`-th.
+     */
+    template <std::size_t I, typename Make>
+    RatingFunction makeRegisteredFunction(const std::string &functionType, Make &&make)
+    {
+        if constexpr (I == std::variant_size_v<RatingFunction>)
+        {
+            throw std::invalid_argument("The function type " + functionType + " does not exists.");
+        }
+        else
+        {
+            using Function = std::variant_alternative_t<I, RatingFunction>;
+            if (functionType == Function::name)
+            {
+                return make(static_cast<Function *>(nullptr));
+            }
+            return makeRegisteredFunction<I + 1>(functionType, make);
+        }
+    }
+}
+
+// Tanh
+
+ratingFunctions::Tanh ratingFunctions::Tanh::fromJson(const nlohmann::json &parameters)
+{
+    return {readParameters<4>(parameters, "p0"), readParameters<4>(parameters, "p5")};
+}
+
+ratingFunctions::Tanh ratingFunctions::Tanh::fromParameters(const std::vector<double> &parameters)
+{
+    return {{parameters[0], parameters[1], parameters[2], parameters[3]},
+            {parameters[4], parameters[5], parameters[6], parameters[7]}};
+}
+
+std::vector<double> ratingFunctions::Tanh::getParameters() const
+{
+    std::vector<double> parameters(p0.begin(), p0.end());
+    parameters.insert(parameters.end(), p5.begin(), p5.end());
+    return parameters;
+}
+
+void ratingFunctions::Tanh::computeProbabilities(int value, std::vector<double> &probabilities) const
+{
+    probabilities[0] = functionTanh(p0, value);
+    probabilities[5] = functionTanh(p5, value);
+    shareRest(probabilities);
+}
+
+// Constant
+
+ratingFunctions::Constant ratingFunctions::Constant::fromJson(const nlohmann::json &parameters)
+{
+    return {readParameters<1>(parameters, "p0")[0], readParameters<1>(parameters, "p5")[0]};
+}
+
+ratingFunctions::Constant ratingFunctions::Constant::fromParameters(const std::vector<double> & /* parameters */)
+{
+    throwNoFlatParameters(name);
+}
+
+std::vector<double> ratingFunctions::Constant::getParameters() const
+{
+    throwNoFlatParameters(name);
+}
+
+void ratingFunctions::Constant::computeProbabilities(int /* value */, std::vector<double> &probabilities) const
+{
+    probabilities[0] = p0;
+    probabilities[5] = p5;
+    shareRest(probabilities);
+}
+
+// Linear
+
+ratingFunctions::Linear ratingFunctions::Linear::fromJson(const nlohmann::json &parameters)
+{
+    return {readParameters<2>(parameters, "p0"), readParameters<2>(parameters, "p5")};
+}
+
+ratingFunctions::Linear ratingFunctions::Linear::fromParameters(const std::vector<double> & /* parameters */)
+{
+    throwNoFlatParameters(name);
+}
+
+std::vector<double> ratingFunctions::Linear::getParameters() const
+{
+    throwNoFlatParameters(name);
+}
+
+void ratingFunctions::Linear::computeProbabilities(int value, std::vector<double> &probabilities) const
+{
+    probabilities[0] = functionLinear(p0, value);
+    probabilities[5] = functionLinear(p5, value);
+    shareRest(probabilities);
+}
+
+// Gaussian
+
+ratingFunctions::Gaussian ratingFunctions::Gaussian::fromJson(const nlohmann::json &parameters)
+{
+    return {{readParameters<3>(parameters, "p1"), readParameters<3>(parameters, "p2"),
+             readParameters<3>(parameters, "p3"), readParameters<3>(parameters, "p4"),
+             readParameters<3>(parameters, "p5")}};
+}
+
+ratingFunctions::Gaussian ratingFunctions::Gaussian::fromParameters(const std::vector<double> &parameters)
+{
+    // The entries 6 and 10 of the flat vectors of the optimizations are not used
+    return {{{{parameters[0], parameters[1], parameters[2]},
+              {parameters[3], parameters[4], parameters[5]},
+              {parameters[7], parameters[8], parameters[9]},
+              {parameters[11], parameters[12], parameters[13]},
+              {parameters[14], parameters[15], parameters[16]}}}};
+}
+
+std::vector<double> ratingFunctions::Gaussian::getParameters() const
+{
+    std::vector<double> parameters;
+    for (const auto &pRating : p)
+    {
+        parameters.insert(parameters.end(), pRating.begin(), pRating.end());
+    }
+    return parameters;
+}
+
+void ratingFunctions::Gaussian::computeProbabilities(int value, std::vector<double> &probabilities) const
+{
+    for (int iRating{1}; iRating <= 5; ++iRating)
+    {
+        probabilities[iRating] = functionGaussian(p[iRating - 1], value);
+    }
+    probabilities[0] = 1 - probabilities[1] - probabilities[2] - probabilities[3] - probabilities[4] - probabilities[5];
+}
+
+// MNSLinear
+
+ratingFunctions::MNSLinear ratingFunctions::MNSLinear::fromJson(const nlohmann::json &parameters)
+{
+    return {readParameters<2>(parameters, "mns")};
+}
+
+ratingFunctions::MNSLinear ratingFunctions::MNSLinear::fromParameters(const std::vector<double> &parameters)
+{
+    return {{parameters[0], parameters[1]}};
+}
+
+std::vector<double> ratingFunctions::MNSLinear::getParameters() const
+{
+    return {mns.begin(), mns.end()};
+}
+
+void ratingFunctions::MNSLinear::computeProbabilities(int value, std::vector<double> &probabilities) const
+{
+    const double meanNumberOfStars{mns[0] + 5. * mns[1] * value / 99.};
+    if (meanNumberOfStars <= 0.)
+    {
+        probabilities[0] = 1.;
+    }
+    else if (meanNumberOfStars >= 5.)
+    {
+        probabilities[5] = 1.;
+    }
+    else
+    {
+        const int iRating{static_cast<int>(meanNumberOfStars)};
+        probabilities[iRating] = 1 - (meanNumberOfStars - iRating);
+        probabilities[iRating + 1] = meanNumberOfStars - iRating;
+    }
+}
+
+// BotConst
+
+ratingFunctions::BotConst ratingFunctions::BotConst::fromJson(const nlohmann::json &parameters)
+{
+    return {readParameters<6>(parameters, "probas")};
+}
+
+ratingFunctions::BotConst ratingFunctions::BotConst::fromParameters(const std::vector<double> & /* parameters */)
+{
+    throwNoFlatParameters(name);
+}
+
+std::vector<double> ratingFunctions::BotConst::getParameters() const
+{
+    throwNoFlatParameters(name);
+}
+
+void ratingFunctions::BotConst::computeProbabilities(int /* value */, std::vector<double> &probabilities) const
+{
+    for (int iRating{0}; iRating < probabilities.size(); ++iRating)
+    {
+        probabilities[iRating] = probas[iRating];
+    }
+}
+
+// BotTanh
+
+ratingFunctions::BotTanh ratingFunctions::BotTanh::fromJson(const nlohmann::json &parameters)
+{
+    return {readParameters<2>(parameters, "p0"), readParameters<2>(parameters, "p5")};
+}
+
+ratingFunctions::BotTanh ratingFunctions::BotTanh::fromParameters(const std::vector<double> & /* parameters */)
+{
+    throwNoFlatParameters(name);
+}
+
+std::vector<double> ratingFunctions::BotTanh::getParameters() const
+{
+    throwNoFlatParameters(name);
+}
+
+void ratingFunctions::BotTanh::computeProbabilities(int value, std::vector<double> &probabilities) const
+{
+    probabilities[0] = functionTanh({0.5, 0.5, p0[0], p0[1]}, value);
+    probabilities[5] = functionTanh({0.5, 0.5, p5[0], p5[1]}, value);
+    shareRest(probabilities);
+}
+
+// Registry
+
+RatingFunction makeRatingFunction(const nlohmann::json &parameters)
+{
+    return makeRegisteredFunction<0>(parameters.at("functionType").get<std::string>(),
+                                     [&](auto *type) -> RatingFunction
+                                     { return std::remove_pointer_t<decltype(type)>::fromJson(parameters); });
+}
+
+RatingFunction makeRatingFunction(const std::vector<double> &parameters, const std::string &functionType)
+{
+    return makeRegisteredFunction<0>(functionType,
+                                     [&](auto *type) -> RatingFunction
+                                     { return std::remove_pointer_t<decltype(type)>::fromParameters(parameters); });
+}
+
+std::string getFunctionType(const RatingFunction &function)
+{
+    return std::visit([](const auto &f) -> std::string { return f.name; }, function);
+}
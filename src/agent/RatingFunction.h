@@ -0,0 +1,164 @@
+#ifndef RATING_FUNCTION_H
+#define RATING_FUNCTION_H
+
+#include <array>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief The parametric functions giving the probabilities of the ratings of a `RatingStrategy`.
+ *
+ * Each function is a type holding its parameters, read once from the JSON of the strategy, and named by the
+ * `functionType` entry of that JSON. A function type provides:
+ * - `static constexpr const char *name`, its `functionType`;
+ * - `static F fromJson(const nlohmann::json &)`, reading its parameters;
+ * - `static F fromParameters(const std::vector<double> &)` and `std::vector<double> getParameters() const`,
+ *   converting its parameters from and to the flat vectors of the optimizations, which throw
+ *   `std::invalid_argument` for the functions that are not optimized;
+ * - `void computeProbabilities(int value, std::vector<double> &probabilities) const`, filling the 6
+ *   probabilities, initially 0, of the ratings of a cell of the given value.
+ *
+ * A new function is registered by adding its type to `RatingFunction`, without any other change.
+ */
+namespace ratingFunctions
+{
+    /**
+     * @brief `p0 + p1 * tanh((value - p2) / 99 * p3)` for the ratings 0 and 5, the others sharing the rest.
+     */
+    struct Tanh
+    {
+        static constexpr const char *name{"tanh"};
+        std::array<double, 4> p0;
+        std::array<double, 4> p5;
+
+        static Tanh fromJson(const nlohmann::json &parameters);
+        static Tanh fromParameters(const std::vector<double> &parameters);
+        [[nodiscard]] std::vector<double> getParameters() const;
+        void computeProbabilities(int value, std::vector<double> &probabilities) const;
+    };
+
+    /**
+     * @brief Constant probabilities of the ratings 0 and 5, the others sharing the rest.
+     */
+    struct Constant
+    {
+        static constexpr const char *name{"constant"};
+        double p0;
+        double p5;
+
+        static Constant fromJson(const nlohmann::json &parameters);
+        static Constant fromParameters(const std::vector<double> &parameters);
+        [[nodiscard]] std::vector<double> getParameters() const;
+        void computeProbabilities(int value, std::vector<double> &probabilities) const;
+    };
+
+    /**
+     * @brief `clip(p0 + p1 * value / 99, 0, 1)` for the ratings 0 and 5, the others sharing the rest.
+     */
+    struct Linear
+    {
+        static constexpr const char *name{"linear"};
+        std::array<double, 2> p0;
+        std::array<double, 2> p5;
+
+        static Linear fromJson(const nlohmann::json &parameters);
+        static Linear fromParameters(const std::vector<double> &parameters);
+        [[nodiscard]] std::vector<double> getParameters() const;
+        void computeProbabilities(int value, std::vector<double> &probabilities) const;
+    };
+
+    /**
+     * @brief `clip(p0 * exp(-((value - p1) / 99 * p2)^2), 0, 1)` for the ratings 1 to 5, the rating 0 taking the
+     * rest.
+     */
+    struct Gaussian
+    {
+        static constexpr const char *name{"gaussian"};
+        // Parameters of the ratings 1 to 5
+        std::array<std::array<double, 3>, 5> p;
+
+        static Gaussian fromJson(const nlohmann::json &parameters);
+        static Gaussian fromParameters(const std::vector<double> &parameters);
+        [[nodiscard]] std::vector<double> getParameters() const;
+        void computeProbabilities(int value, std::vector<double> &probabilities) const;
+    };
+
+    /**
+     * @brief Mean number of stars `p0 + 5 * p1 * value / 99`, split between the two ratings around it.
+     */
+    struct MNSLinear
+    {
+        static constexpr const char *name{"mns_linear"};
+        std::array<double, 2> mns;
+
+        static MNSLinear fromJson(const nlohmann::json &parameters);
+        static MNSLinear fromParameters(const std::vector<double> &parameters);
+        [[nodiscard]] std::vector<double> getParameters() const;
+        void computeProbabilities(int value, std::vector<double> &probabilities) const;
+    };
+
+    /**
+     * @brief Bot giving constant probabilities to every rating.
+     */
+    struct BotConst
+    {
+        static constexpr const char *name{"bot_const"};
+        std::array<double, 6> probas;
+
+        static BotConst fromJson(const nlohmann::json &parameters);
+        static BotConst fromParameters(const std::vector<double> &parameters);
+        [[nodiscard]] std::vector<double> getParameters() const;
+        void computeProbabilities(int value, std::vector<double> &probabilities) const;
+    };
+
+    /**
+     * @brief Bot-flavoured `Tanh`, whose ratings 0 and 5 use `Tanh` with the parameters `{0.5, 0.5, p0, p1}`.
+     */
+    struct BotTanh
+    {
+        static constexpr const char *name{"bot_tanh"};
+        std::array<double, 2> p0;
+        std::array<double, 2> p5;
+
+        static BotTanh fromJson(const nlohmann::json &parameters);
+        static BotTanh fromParameters(const std::vector<double> &parameters);
+        [[nodiscard]] std::vector<double> getParameters() const;
+        void computeProbabilities(int value, std::vector<double> &probabilities) const;
+    };
+}
+
+/**
+ * @brief The registered rating functions, see `ratingFunctions`.
+ */
+using RatingFunction = std::variant<ratingFunctions::Tanh, ratingFunctions::Constant, ratingFunctions::Linear,
+                                    ratingFunctions::Gaussian, ratingFunctions::MNSLinear,
+                                    ratingFunctions::BotConst, ratingFunctions::BotTanh>;
+
+/**
+ * @brief Build the rating function described by a JSON parameter object.
+ *
+ * @param parameters JSON parameters, whose `functionType` entry names the function.
+ * @return The rating function.
+ * @throws std::invalid_argument If no function has this name.
+ */
+RatingFunction makeRatingFunction(const nlohmann::json &parameters);
+
+/**
+ * @brief Build a rating function from a flat parameter vector.
+ *
+ * @param parameters Flat vector of parameters interpreted according to `functionType`.
+ * @param functionType Name of the function.
+ * @return The rating function.
+ * @throws std::invalid_argument If no function has this name, or if it has no flat parameters.
+ */
+RatingFunction makeRatingFunction(const std::vector<double> &parameters, const std::string &functionType);
+
+/**
+ * @brief Get the name of a rating function, as given by the `functionType` entry of its JSON.
+ */
+std::string getFunctionType(const RatingFunction &function);
+
+#endif
@@ -1,20 +1,25 @@
-#include <cmath>     // std::exp, std::pow, std::tanh
+#include <limits>    // std::numeric_limits
+#include <memory>    // std::make_shared
 #include <numeric>   // std::iota
 #include <stdexcept> // std::invalid_argument
-#include <string>
+#include <string>    // std::to_string
+#include <utility>   // std::move
+#include <variant>   // std::visit
 #include <vector>
 
 #include <nlohmann/json.hpp>
 
+#include "agent/RatingFunction.h"
 #include "agent/RatingStrategy.h"
 #include "random/myRandom.h"
 
 RatingStrategy::RatingStrategy(int minRating, int maxRating, const nlohmann::json &parameters)
-    : m_ratings{std::vector<int>(maxRating - minRating + 1)},
-      m_parameters{parameters},
+    : mp_compiled{},
       m_agentType{AgentType::UNDEFINED}
 {
-    std::iota(m_ratings.begin(), m_ratings.end(), minRating);
+    std::vector<int> ratings(maxRating - minRating + 1);
+    std::iota(ratings.begin(), ratings.end(), minRating);
+    mp_compiled = compile(makeRatingFunction(parameters), std::move(ratings));
 }
 
 RatingStrategy::RatingStrategy(const nlohmann::json &parameters)
@@ -23,163 +28,118 @@ RatingStrategy::RatingStrategy(const nlohmann::json &parameters)
 }
 
 RatingStrategy::RatingStrategy(const std::vector<double> &parameters, const std::string &functionType)
-    : RatingStrategy(0, 5, to_json(parameters, functionType))
+    : RatingStrategy(makeRatingFunction(parameters, functionType))
 {
 }
 
-int RatingStrategy::chooseRating(int value) const
+RatingStrategy::RatingStrategy(const RatingFunction &function)
+    : mp_compiled{compile(function, {0, 1, 2, 3, 4, 5})},
+      m_agentType{AgentType::UNDEFINED}
 {
-    return myRandom::choice(m_ratings, computeProbabilities(value));
 }
 
-std::vector<double> RatingStrategy::computeProbabilities(int value) const
+void RatingStrategy::setParameters(const nlohmann::json &parameters)
 {
-    const std::string functionType{m_parameters["functionType"].get<std::string>()};
-    std::vector<double> probabilities(6, 0.);
-    if (functionType == "tanh")
-    {
-        probabilities[0] = functionTanh(m_parameters["p0"], value);
-        probabilities[5] = functionTanh(m_parameters["p5"], value);
-        const double p1234{(1. - probabilities[0] - probabilities[5]) / 4.};
-        probabilities[1] = p1234;
-        probabilities[2] = p1234;
-        probabilities[3] = p1234;
-        probabilities[4] = p1234;
-    }
-    else if (functionType == "constant")
-    {
-        probabilities[0] = functionConstant(m_parameters["p0"], value);
-        probabilities[5] = functionConstant(m_parameters["p5"], value);
-        const double p1234{(1. - probabilities[0] - probabilities[5]) / 4.};
-        probabilities[1] = p1234;
-        probabilities[2] = p1234;
-        probabilities[3] = p1234;
-        probabilities[4] = p1234;
-    }
-    else if (functionType == "linear")
-    {
-        probabilities[0] = functionLinear(m_parameters["p0"], value);
-        probabilities[5] = functionLinear(m_parameters["p5"], value);
-        const double p1234{(1. - probabilities[0] - probabilities[5]) / 4.};
-        probabilities[1] = p1234;
-        probabilities[2] = p1234;
-        probabilities[3] = p1234;
-        probabilities[4] = p1234;
-    }
-    else if (functionType == "gaussian")
-    {
-        probabilities[1] = functionGaussian(m_parameters["p1"], value);
-        probabilities[2] = functionGaussian(m_parameters["p2"], value);
-        probabilities[3] = functionGaussian(m_parameters["p3"], value);
-        probabilities[4] = functionGaussian(m_parameters["p4"], value);
-        probabilities[5] = functionGaussian(m_parameters["p5"], value);
-        probabilities[0] = 1 - probabilities[1] - probabilities[2] - probabilities[3] - probabilities[4] - probabilities[5];
-    }
-    else if (functionType == "mns_linear")
-    {
-        computeProbabilitiesMNSLinear(probabilities, m_parameters["mns"], value);
-    }
-    else if (functionType == "bot_const")
-    {
-        for (int i{0}; i < probabilities.size(); ++i)
+    setFunction(makeRatingFunction(parameters));
+}
+
+void RatingStrategy::setFunction(const RatingFunction &function)
+{
+    mp_compiled = compile(function, mp_compiled->ratings);
+}
+
+std::shared_ptr<const RatingStrategy::CompiledStrategy> RatingStrategy::compile(const RatingFunction &function,
+                                                                                std::vector<int> ratings)
+{
+    const int numberOfRatings{static_cast<int>(ratings.size())};
+    auto compiled{std::make_shared<CompiledStrategy>()};
+    compiled->function = function;
+    compiled->ratings = std::move(ratings);
+    compiled->cumulatives.resize((maxTabulatedValue + 1) * numberOfRatings);
+    compiled->sums.resize(maxTabulatedValue + 1);
+    compiled->lastRatings.resize(maxTabulatedValue + 1);
+    for (int value{0}; value <= maxTabulatedValue; ++value)
+    {
+        const std::vector<double> probabilities{computeProbabilities(function, value)};
+        if (probabilities.size() != numberOfRatings)
         {
-            probabilities[i] = m_parameters["probas"][i];
+            throw std::invalid_argument("RatingStrategy: The function gives a probability for each of " +
+                                        std::to_string(probabilities.size()) + " ratings instead of " +
+                                        std::to_string(numberOfRatings) + ".");
         }
-    }
-    else if (functionType == "bot_tanh")
-    {
-        probabilities[0] = functionBotTanh(m_parameters["p0"], value);
-        probabilities[5] = functionBotTanh(m_parameters["p5"], value);
-        const double p1234{(1. - probabilities[0] - probabilities[5]) / 4.};
-        probabilities[1] = p1234;
-        probabilities[2] = p1234;
-        probabilities[3] = p1234;
-        probabilities[4] = p1234;
-    }
-    else
-    {
-        throw std::invalid_argument("The function type " + functionType + " does not exists.");
-    }
 
-    return probabilities;
+        double *cumulatives{&compiled->cumulatives[value * numberOfRatings]};
+        double sum{0.};
+        double cumulative{0.};
+        int iLast{0};
+        for (int iRating{0}; iRating < numberOfRatings; ++iRating)
+        {
+            sum += probabilities[iRating];
+            cumulatives[iRating] = -std::numeric_limits<double>::infinity();
+            if (probabilities[iRating] > 0.)
+            {
+                cumulative += probabilities[iRating];
+                cumulatives[iRating] = cumulative;
+                iLast = iRating;
+            }
+        }
+        compiled->sums[value] = sum;
+        compiled->lastRatings[value] = iLast;
+    }
+    return compiled;
 }
 
-void RatingStrategy::computeProbabilitiesMNSLinear(std::vector<double> &probabilities,
-                                                   const std::vector<double> &parameters, int value) const
+int RatingStrategy::chooseRating(int value) const
 {
-    const double mns{parameters[0] + 5. * parameters[1] * value / 99.};
-    if (mns <= 0.)
-    {
-        probabilities[0] = 1.;
-    }
-    else if (mns >= 5.)
+    const CompiledStrategy &compiled{*mp_compiled};
+    if (value < 0 || value > maxTabulatedValue)
     {
-        probabilities[5] = 1.;
+        return myRandom::choice(compiled.ratings, computeProbabilities(value));
     }
-    else
+
+    const int numberOfRatings{static_cast<int>(compiled.ratings.size())};
+    const double *cumulatives{getCumulatives(value)};
+    const double target{myRandom::rand() * compiled.sums[value]};
+    for (int iRating{0}; iRating < numberOfRatings; ++iRating)
     {
-        const int mns_int{static_cast<int>(mns)};
-        probabilities[mns_int] = 1 - (mns - mns_int);
-        probabilities[mns_int + 1] = mns - mns_int;
+        if (cumulatives[iRating] >= target)
+        {
+            return compiled.ratings[iRating];
+        }
     }
+    return compiled.ratings[compiled.lastRatings[value]];
 }
 
-double RatingStrategy::functionTanh(const std::vector<double> &parameters, int value)
+const double *RatingStrategy::getCumulatives(int value) const
 {
-    return parameters[0] + parameters[1] * std::tanh((value - parameters[2]) / 99. * parameters[3]);
+    return &mp_compiled->cumulatives[value * mp_compiled->ratings.size()];
 }
 
-double RatingStrategy::functionBotTanh(const std::vector<double> &parameters, int value)
+double RatingStrategy::getSumOfProbabilities(int value) const
 {
-    return functionTanh(std::vector{0.5, 0.5, parameters[0], parameters[1]}, value);
-    // return (1 + std::tanh((value - parameters[0]) / 99. * parameters[1])) / 2;
+    return mp_compiled->sums[value];
 }
 
-double RatingStrategy::functionConstant(const std::vector<double> &parameters, int value)
+int RatingStrategy::getLastRatingIndex(int value) const
 {
-    return parameters[0];
+    return mp_compiled->lastRatings[value];
 }
 
-double RatingStrategy::functionLinear(const std::vector<double> &parameters, int value)
+std::vector<double> RatingStrategy::computeProbabilities(int value) const
 {
-    double result = parameters[0] + parameters[1] * value / 99.;
-    result = std::max(0.0, std::min(result, 1.0)); // Clip the result to the range [0, 1]
-    return result;
+    return computeProbabilities(mp_compiled->function, value);
 }
 
-double RatingStrategy::functionGaussian(const std::vector<double> &parameters, int value)
+std::vector<double> RatingStrategy::computeProbabilities(const RatingFunction &function, int value)
 {
-    double result = parameters[0] * std::exp(-std::pow((value - parameters[1]) / 99. * parameters[2], 2));
-    result = std::max(0.0, std::min(result, 1.0)); // Clip the result to the range [0, 1]
-    return result;
+    std::vector<double> probabilities(6, 0.);
+    std::visit([&](const auto &f) { f.computeProbabilities(value, probabilities); }, function);
+    return probabilities;
 }
 
-nlohmann::json RatingStrategy::to_json(const std::vector<double> &parameters, const std::string &functionType)
+const std::vector<int> &RatingStrategy::getRatings() const
 {
-    nlohmann::json j;
-    j["functionType"] = functionType;
-    if (functionType == "tanh")
-    {
-        j["p0"] = {parameters[0], parameters[1], parameters[2], parameters[3]};
-        j["p5"] = {parameters[4], parameters[5], parameters[6], parameters[7]};
-    }
-    else if (functionType == "gaussian")
-    {
-        j["p1"] = {parameters[0], parameters[1], parameters[2]};
-        j["p2"] = {parameters[3], parameters[4], parameters[5]};
-        j["p3"] = {parameters[7], parameters[8], parameters[9]};
-        j["p4"] = {parameters[11], parameters[12], parameters[13]};
-        j["p5"] = {parameters[14], parameters[15], parameters[16]};
-    }
-    else if (functionType == "mns_linear")
-    {
-        j["mns"] = {parameters[0], parameters[1]};
-    }
-    else
-    {
-        throw std::invalid_argument("The function type " + functionType + "does not exists.");
-    }
-    return j;
+    return mp_compiled->ratings;
 }
 
 const AgentType &RatingStrategy::getAgentType() const
@@ -189,32 +149,10 @@ const AgentType &RatingStrategy::getAgentType() const
 
 std::vector<double> RatingStrategy::getParameters() const
 {
-    const std::string functionType{m_parameters["functionType"].get<std::string>()};
-    if (functionType == "mns_linear")
-    {
-        return m_parameters["mns"].get<std::vector<double>>();
-    }
-    else if (functionType == "tanh")
-    {
-        std::vector<double> params;
-        for (const auto &v : m_parameters["p0"])
-            params.push_back(v.get<double>());
-        for (const auto &v : m_parameters["p5"])
-            params.push_back(v.get<double>());
-        return params;
-    }
-    else if (functionType == "gaussian")
-    {
-        std::vector<double> params;
-        for (const auto &key : {"p1", "p2", "p3", "p4", "p5"})
-        {
-            for (const auto &v : m_parameters[key])
-                params.push_back(v.get<double>());
-        }
-        return params;
-    }
-    else
-    {
-        throw std::invalid_argument("getParameters() is not supported for function type '" + functionType + "'.");
-    }
+    return std::visit([](const auto &function) { return function.getParameters(); }, mp_compiled->function);
+}
+
+std::string RatingStrategy::getFunctionType() const
+{
+    return ::getFunctionType(mp_compiled->function);
 }
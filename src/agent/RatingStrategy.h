@@ -1,11 +1,14 @@
 #ifndef RATING_STRATEGY_H
 #define RATING_STRATEGY_H
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include <nlohmann/json.hpp>
 
 #include "agent/Cell.h"
+#include "agent/RatingFunction.h"
 
 /**
  * @brief Behavioural profile of an agent.
@@ -31,11 +34,21 @@ enum class AgentType
  *
  * The rating is drawn from a discrete distribution whose probabilities are computed by one of
  * several parametric functions (tanh, constant, linear, gaussian, mns_linear, bot_const, bot_tanh)
- * selected via the `functionType` entry of the parameters JSON.
+ * selected via the `functionType` entry of the parameters JSON. The JSON is only read when the parameters are
+ * set, into the typed function of `RatingFunction`.
+ *
+ * The function is evaluated once per cell value when the parameters are set, and the cumulative probabilities
+ * of the ratings are stored in a table, so that a rating only costs a uniform number and a search over the
+ * ratings. The table is immutable and shared by the copies of the strategy.
  */
 class RatingStrategy
 {
 public:
+    /**
+     * @brief Largest tabulated cell value, the values of the maps being in [0, 99].
+     */
+    static constexpr int maxTabulatedValue{99};
+
     /**
      * @brief Build a rating strategy from a JSON parameter object with an explicit rating range.
      *
@@ -60,104 +73,141 @@ public:
      */
     RatingStrategy(const std::vector<double> &parameters, const std::string &functionType);
 
+    /**
+     * @brief Build a rating strategy from a probability function with the default rating range [0, 5].
+     *
+     * @param function The probability function to use.
+     */
+    explicit RatingStrategy(const RatingFunction &function);
+
+    /**
+     * @brief Replace the parameters of the strategy, and rebuild the table of its probabilities.
+     *
+     * @param parameters JSON parameters describing the probability function to use.
+     */
+    void setParameters(const nlohmann::json &parameters);
+
+    /**
+     * @brief Replace the probability function of the strategy, and rebuild the table of its probabilities.
+     *
+     * @param function The probability function to use.
+     */
+    void setFunction(const RatingFunction &function);
+
     /**
      * @brief Pick a rating for a cell with the given value.
      *
      * @param value The value of the cell being rated.
-     * @return The rating drawn from the probability distribution.
+     * @return The rating drawn from the probability distribution, as `myRandom::choice` would from the
+     * probabilities of `computeProbabilities`.
      */
     int chooseRating(int value) const;
 
     /**
-     * @brief Get the agent type associated with the strategy.
+     * @brief Get the tabulated running sums of the probabilities of the ratings for a cell of the given value.
      *
-     * @return A reference to the agent type.
+     * `chooseRating` draws the first rating whose running sum is at least a uniform number times
+     * `getSumOfProbabilities(value)`, or the rating of index `getLastRatingIndex(value)` if rounding leaves the
+     * target above every running sum. Only the positive probabilities are summed, and the running sum of a rating
+     * whose probability is not positive is -infinity, so that it is never drawn.
+     *
+     * @param value The value of the cell being rated, in [0, maxTabulatedValue].
+     * @return The running sum of each rating of `getRatings()`, shared by the copies of the strategy and valid
+     *         until the parameters of the strategy are replaced.
      */
-    const AgentType &getAgentType() const;
+    const double *getCumulatives(int value) const;
 
     /**
-     * @brief Get the parameters of the strategy as a flat vector.
+     * @brief Get the sum of the probabilities of the ratings for a cell of the given value, see `getCumulatives`.
      *
-     * @return The parameters of the underlying probability function.
+     * @param value The value of the cell being rated, in [0, maxTabulatedValue].
      */
-    std::vector<double> getParameters() const;
+    double getSumOfProbabilities(int value) const;
 
-private:
-    nlohmann::json m_parameters;
-    std::vector<int> m_ratings;
-    AgentType m_agentType;
+    /**
+     * @brief Get the index of the last rating of positive probability for a cell of the given value, see
+     * `getCumulatives`.
+     *
+     * @param value The value of the cell being rated, in [0, maxTabulatedValue].
+     */
+    int getLastRatingIndex(int value) const;
 
     /**
      * @brief Compute the rating probabilities for a cell of the given value.
      *
      * @param value The value of the cell being rated.
-     * @return The probability of each rating in `m_ratings`.
+     * @return The probability of each rating of `getRatings()`.
      */
     std::vector<double> computeProbabilities(int value) const;
 
     /**
-     * @brief Fill `probabilities` for the "mns_linear" function.
+     * @brief Get the ratings the strategy can give, in increasing order.
      *
-     * @param probabilities Output vector to be filled.
-     * @param parameters Parameters of the mns_linear function.
-     * @param value The value of the cell being rated.
+     * @return A reference to the ratings.
      */
-    void computeProbabilitiesMNSLinear(std::vector<double> &probabilities,
-                                       const std::vector<double> &parameters, int value) const;
+    const std::vector<int> &getRatings() const;
 
     /**
-     * @brief `p0 + p1 * tanh((value - p2) / 99 * p3)`.
+     * @brief Get the agent type associated with the strategy.
      *
-     * @param parameters The four function parameters `[p0, p1, p2, p3]`.
-     * @param value The cell value.
-     * @return The resulting probability.
+     * @return A reference to the agent type.
      */
-    static double functionTanh(const std::vector<double> &parameters, int value);
+    const AgentType &getAgentType() const;
 
     /**
-     * @brief Bot-flavoured tanh: equivalent to `functionTanh({0.5, 0.5, p0, p1}, value)`.
+     * @brief Get the parameters of the strategy as a flat vector.
      *
-     * @param parameters The two function parameters `[p0, p1]`.
-     * @param value The cell value.
-     * @return The resulting probability.
+     * @return The parameters of the underlying probability function.
+     * @throws std::invalid_argument If the function has no flat parameters.
      */
-    static double functionBotTanh(const std::vector<double> &parameters, int value);
+    std::vector<double> getParameters() const;
 
     /**
-     * @brief Constant function: returns `parameters[0]`.
-     *
-     * @param parameters The single function parameter.
-     * @param value Unused.
-     * @return The constant probability.
+     * @brief Get the name of the probability function, as given by the `functionType` entry of its JSON.
      */
-    static double functionConstant(const std::vector<double> &parameters, int value);
+    std::string getFunctionType() const;
 
+private:
     /**
-     * @brief `clip(p0 + p1 * value / 99, 0, 1)`.
+     * @brief The probability function of a strategy, its ratings and the cumulative probabilities of the ratings
+     * of every tabulated cell value, immutable and shared by the copies of the strategy.
      *
-     * @param parameters The two function parameters `[p0, p1]`.
-     * @param value The cell value.
-     * @return The resulting probability, clamped to [0, 1].
+     * The cumulative probabilities reproduce the scan of `myRandom::randIndexWeighted`, so that the ratings
+     * drawn from the table are the same as those drawn from the probabilities, including when a fitted strategy
+     * gives slightly negative probabilities.
      */
-    static double functionLinear(const std::vector<double> &parameters, int value);
+    struct CompiledStrategy
+    {
+        RatingFunction function;
+        std::vector<int> ratings;
+        // Running sums of the positive probabilities, by value then by rating, -infinity for the ratings whose
+        // probability is not positive
+        std::vector<double> cumulatives;
+        // Sum of the probabilities of each value
+        std::vector<double> sums;
+        // Index of the last rating of positive probability of each value, drawn when rounding leaves the target
+        // above every running sum
+        std::vector<int> lastRatings;
+    };
+
+    // Shared, so that the agents given the same strategy only hold a pointer to it
+    std::shared_ptr<const CompiledStrategy> mp_compiled;
+    AgentType m_agentType;
 
     /**
-     * @brief `clip(p0 * exp(-((value - p1) / 99 * p2)^2), 0, 1)`.
+     * @brief Tabulate the probabilities of the ratings given by a function.
      *
-     * @param parameters The three function parameters `[p0, p1, p2]`.
-     * @param value The cell value.
-     * @return The resulting probability, clamped to [0, 1].
+     * @param function The probability function.
+     * @param ratings The ratings, in increasing order.
+     * @return The compiled strategy.
+     * @throws std::invalid_argument If the function does not give a probability for each rating.
      */
-    static double functionGaussian(const std::vector<double> &parameters, int value);
+    static std::shared_ptr<const CompiledStrategy> compile(const RatingFunction &function, std::vector<int> ratings);
 
     /**
-     * @brief Convert a flat parameter vector into the JSON form expected by the constructor.
-     *
-     * @param parametersStars Flat vector of parameters.
-     * @param functionType Name of the probability function.
-     * @return The JSON representation of the parameters.
+     * @brief Compute the probabilities of the ratings given by a function for a cell of the given value.
      */
-    static nlohmann::json to_json(const std::vector<double> &parametersStars, const std::string &functionType);
+    static std::vector<double> computeProbabilities(const RatingFunction &function, int value);
 };
 
 #endif
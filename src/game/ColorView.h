@@ -0,0 +1,180 @@
+#ifndef COLOR_VIEW_H
+#define COLOR_VIEW_H
+
+#include <utility>
+#include <vector>
+
+#include "game/Topology.h"
+
+/**
+ * @brief Read-only view of the colors of a game, i.e. the fraction of all the stars held by each cell.
+ *
+ * The colors are not stored: each one is computed on access from the stars of the cell and the total
+ * number of stars, which the game maintains incrementally. The stars may be stored up to a common
+ * scale factor (see `getScale`), which cancels out in the colors. The cells holding stars are also listed,
+ * by index and by decreasing stars, so that large maps with few occupied cells can be scanned in time
+ * proportional to the occupied cells, and the `k` most rated cells found in time proportional to `k`. The
+ * view does not own its data and is only valid until the next change of round.
+ *
+ * If the game has a `Topology`, the colors smoothed over the neighbourhood of each cell are also available,
+ * the game maintaining the stars of each neighbourhood as the stars are given.
+ */
+class ColorView
+{
+public:
+    /**
+     * @brief Build a view of the colors.
+     *
+     * @param stars The number of stars of each cell, divided by `scale`.
+     * @param occupiedCells The cells whose stars are not 0, sorted by increasing index.
+     * @param cellsByStars The same cells, sorted by decreasing stars then by increasing index.
+     * @param sumOfStars The sum of `stars`.
+     * @param scale The factor converting `stars` to actual numbers of stars.
+     */
+    ColorView(const std::vector<double> &stars, const std::vector<int> &occupiedCells,
+              const std::vector<int> &cellsByStars, double sumOfStars, double scale)
+        : ColorView(stars, occupiedCells, cellsByStars, sumOfStars, scale, false, nullptr, nullptr)
+    {
+    }
+
+    /**
+     * @brief Build a view of the colors of a game with a topology.
+     *
+     * @param hasIntegerStars If `true`, the stars are the actual numbers of stars of the cells, which are
+     *        integers, as in the games without evaporation.
+     * @param topology The topology of the map, or null if the map has none.
+     * @param smoothedStars The stars of each cell and its neighbours, divided by `scale`, or null if the map
+     *        has no topology.
+     */
+    ColorView(const std::vector<double> &stars, const std::vector<int> &occupiedCells,
+              const std::vector<int> &cellsByStars, double sumOfStars, double scale, bool hasIntegerStars,
+              const Topology *topology, const std::vector<double> *smoothedStars)
+        : mp_stars{&stars},
+          mp_occupiedCells{&occupiedCells},
+          mp_cellsByStars{&cellsByStars},
+          m_sumOfStars{sumOfStars},
+          m_scale{scale},
+          m_hasIntegerStars{hasIntegerStars},
+          mp_topology{topology},
+          mp_smoothedStars{smoothedStars}
+    {
+    }
+
+    /**
+     * @brief Get the color of a cell.
+     *
+     * @param iCell The index of the cell.
+     * @return The fraction of the stars held by the cell, or 0 if no star has been given yet.
+     */
+    [[nodiscard]] double operator[](int iCell) const
+    {
+        return m_sumOfStars == 0. ? 0. : (*mp_stars)[iCell] / m_sumOfStars;
+    }
+
+    /**
+     * @brief Get the number of cells.
+     */
+    [[nodiscard]] int size() const { return static_cast<int>(mp_stars->size()); }
+
+    /**
+     * @brief Check if no star has been given yet, in which case all the colors are 0.
+     */
+    [[nodiscard]] bool isEmpty() const { return m_sumOfStars == 0.; }
+
+    /**
+     * @brief Get the cells holding stars, i.e. whose color is not 0, sorted by increasing index.
+     */
+    [[nodiscard]] const std::vector<int> &getOccupiedCells() const { return *mp_occupiedCells; }
+
+    /**
+     * @brief Get the cells holding stars sorted by decreasing color, the cells of equal colors being sorted by
+     * increasing index.
+     *
+     * The `k` first cells are the `k` most rated cells, the other cells having a color of 0.
+     */
+    [[nodiscard]] const std::vector<int> &getCellsByColor() const { return *mp_cellsByStars; }
+
+    /**
+     * @brief Get the number of stars of each cell, divided by `getScale()`.
+     */
+    [[nodiscard]] const std::vector<double> &getStars() const { return *mp_stars; }
+
+    /**
+     * @brief Get the sum of `getStars()`.
+     */
+    [[nodiscard]] double getSumOfStars() const { return m_sumOfStars; }
+
+    /**
+     * @brief Get the factor converting `getStars()` to actual numbers of stars.
+     *
+     * The scale is 1 for games without evaporation, in which case the stars are integers.
+     */
+    [[nodiscard]] double getScale() const { return m_scale; }
+
+    /**
+     * @brief Check if `getStars()` are the actual numbers of stars of the cells, which are then integers.
+     *
+     * This is the case in the games without evaporation, whose colors are proportional to integers.
+     */
+    [[nodiscard]] bool hasIntegerStars() const { return m_hasIntegerStars; }
+
+    /**
+     * @brief Get the topology of the map, or null if the map has none.
+     */
+    [[nodiscard]] const Topology *getTopology() const { return mp_topology; }
+
+    /**
+     * @brief Get the mean color of a cell and its neighbours. The map must have a topology.
+     *
+     * @param iCell The index of the cell.
+     * @return The mean fraction of the stars held by the cell and its neighbours, or 0 if no star has been
+     *         given yet.
+     */
+    [[nodiscard]] double getSmoothedColor(int iCell) const
+    {
+        return m_sumOfStars == 0. ? 0.
+                                  : (*mp_smoothedStars)[iCell] /
+                                        ((mp_topology->getNeighbours(iCell).size() + 1) * m_sumOfStars);
+    }
+
+    /**
+     * @brief Get the gradient of the smoothed colors at a cell, by finite differences with the next cells along
+     * the rows and the columns. The map must have a topology.
+     *
+     * @param iCell The index of the cell.
+     * @return The derivatives of the smoothed color along the rows and along the columns.
+     */
+    [[nodiscard]] std::pair<double, double> getSmoothedColorGradient(int iCell) const
+    {
+        return {computeDerivative(iCell, 1, 0), computeDerivative(iCell, 0, 1)};
+    }
+
+private:
+    /**
+     * @brief Compute the derivative of the smoothed colors along a direction, by central differences, or by
+     * one-sided differences on the edges of the grid.
+     */
+    [[nodiscard]] double computeDerivative(int iCell, int dx, int dy) const
+    {
+        const int iNext{mp_topology->getShiftedCell(iCell, dx, dy)};
+        const int iPrevious{mp_topology->getShiftedCell(iCell, -dx, -dy)};
+        if (iNext < 0 && iPrevious < 0)
+        {
+            return 0.;
+        }
+        const double next{getSmoothedColor(iNext < 0 ? iCell : iNext)};
+        const double previous{getSmoothedColor(iPrevious < 0 ? iCell : iPrevious)};
+        return (next - previous) / (iNext < 0 || iPrevious < 0 ? 1. : 2.);
+    }
+
+    const std::vector<double> *mp_stars;
+    const std::vector<int> *mp_occupiedCells;
+    const std::vector<int> *mp_cellsByStars;
+    double m_sumOfStars;
+    double m_scale;
+    bool m_hasIntegerStars;
+    const Topology *mp_topology;
+    const std::vector<double> *mp_smoothedStars;
+};
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef DIMENSIONS_H
+#define DIMENSIONS_H
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Dimensions of games known only at run time: numbers of rounds, turns, players and cells.
+ *
+ * The storage sized by one of the dimensions is a `std::vector`. See `FixedDimensions` for the
+ * dimensions known at compile time, which share the same interface.
+ */
+class DynamicDimensions
+{
+public:
+    template <typename T, int Multiple = 1>
+    using TurnArray = std::vector<T>;
+
+    template <typename T>
+    using RoundArray = std::vector<T>;
+
+    template <typename T>
+    using PlayerArray = std::vector<T>;
+
+    template <typename T>
+    using CellArray = std::vector<T>;
+
+    DynamicDimensions(int numberOfRounds, int numberOfTurns, int numberOfPlayers, int numberOfCells)
+        : m_numberOfRounds{numberOfRounds},
+          m_numberOfTurns{numberOfTurns},
+          m_numberOfPlayers{numberOfPlayers},
+          m_numberOfCells{numberOfCells}
+    {
+    }
+
+    [[nodiscard]] int numberOfRounds() const { return m_numberOfRounds; }
+
+    [[nodiscard]] int numberOfTurns() const { return m_numberOfTurns; }
+
+    [[nodiscard]] int numberOfPlayers() const { return m_numberOfPlayers; }
+
+    [[nodiscard]] int numberOfCells() const { return m_numberOfCells; }
+
+    /**
+     * @brief Build an array of `Multiple` entries per turn, all set to `value`.
+     */
+    template <typename T, int Multiple = 1>
+    [[nodiscard]] TurnArray<T, Multiple> makeTurnArray(const T &value) const
+    {
+        return TurnArray<T, Multiple>(Multiple * m_numberOfTurns, value);
+    }
+
+    /**
+     * @brief Build an array of one entry per round, all set to `value`.
+     */
+    template <typename T>
+    [[nodiscard]] RoundArray<T> makeRoundArray(const T &value) const
+    {
+        return RoundArray<T>(m_numberOfRounds, value);
+    }
+
+    /**
+     * @brief Build an array of one entry per player, all set to `value`.
+     */
+    template <typename T>
+    [[nodiscard]] PlayerArray<T> makePlayerArray(const T &value) const
+    {
+        return PlayerArray<T>(m_numberOfPlayers, value);
+    }
+
+    /**
+     * @brief Build an array of one entry per cell, all set to `value`.
+     */
+    template <typename T>
+    [[nodiscard]] CellArray<T> makeCellArray(const T &value) const
+    {
+        return CellArray<T>(m_numberOfCells, value);
+    }
+
+private:
+    int m_numberOfRounds;
+    int m_numberOfTurns;
+    int m_numberOfPlayers;
+    int m_numberOfCells;
+};
+
+/**
+ * @brief Dimensions of games known at compile time.
+ *
+ * The dimensions are constant expressions, so that the loops they bound can be unrolled, and the
+ * storage sized by one of them is a `std::array`, which avoids any heap allocation.
+ */
+template <int NumberOfRounds, int NumberOfTurns, int NumberOfPlayers, int NumberOfCells>
+class FixedDimensions
+{
+public:
+    template <typename T, int Multiple = 1>
+    using TurnArray = std::array<T, Multiple * NumberOfTurns>;
+
+    template <typename T>
+    using RoundArray = std::array<T, NumberOfRounds>;
+
+    template <typename T>
+    using PlayerArray = std::array<T, NumberOfPlayers>;
+
+    template <typename T>
+    using CellArray = std::array<T, NumberOfCells>;
+
+    FixedDimensions() = default;
+
+    /**
+     * @brief Build the dimensions, checking that they match the given run-time dimensions.
+     *
+     * @throw std::invalid_argument If the run-time dimensions differ from the compile-time ones.
+     */
+    FixedDimensions(int numberOfRounds, int numberOfTurns, int numberOfPlayers, int numberOfCells)
+    {
+        if (!matches(numberOfRounds, numberOfTurns, numberOfPlayers, numberOfCells))
+        {
+            throw std::invalid_argument("FixedDimensions: The dimensions do not match the compile-time ones.");
+        }
+    }
+
+    /**
+     * @brief Check if run-time dimensions are equal to the compile-time ones.
+     */
+    [[nodiscard]] static constexpr bool matches(int numberOfRounds, int numberOfTurns, int numberOfPlayers,
+                                                int numberOfCells)
+    {
+        return numberOfRounds == NumberOfRounds && numberOfTurns == NumberOfTurns &&
+               numberOfPlayers == NumberOfPlayers && numberOfCells == NumberOfCells;
+    }
+
+    [[nodiscard]] static constexpr int numberOfRounds() { return NumberOfRounds; }
+
+    [[nodiscard]] static constexpr int numberOfTurns() { return NumberOfTurns; }
+
+    [[nodiscard]] static constexpr int numberOfPlayers() { return NumberOfPlayers; }
+
+    [[nodiscard]] static constexpr int numberOfCells() { return NumberOfCells; }
+
+    template <typename T, int Multiple = 1>
+    [[nodiscard]] static TurnArray<T, Multiple> makeTurnArray(const T &value) { return filled<TurnArray<T, Multiple>>(value); }
+
+    template <typename T>
+    [[nodiscard]] static RoundArray<T> makeRoundArray(const T &value) { return filled<RoundArray<T>>(value); }
+
+    template <typename T>
+    [[nodiscard]] static PlayerArray<T> makePlayerArray(const T &value) { return filled<PlayerArray<T>>(value); }
+
+    template <typename T>
+    [[nodiscard]] static CellArray<T> makeCellArray(const T &value) { return filled<CellArray<T>>(value); }
+
+private:
+    template <typename Array, typename T>
+    static Array filled(const T &value)
+    {
+        Array array;
+        array.fill(value);
+        return array;
+    }
+};
+
+/**
+ * @brief Dimensions of the experiment: 20 rounds of 3 turns, 5 players and 225 cells.
+ */
+using ExperimentDimensions = FixedDimensions<20, 3, 5, 225>;
+
+/**
+ * @brief Call `function` with the fastest dimensions type matching run-time dimensions.
+ *
+ * The function is called with `ExperimentDimensions` if the dimensions are those of the experiment,
+ * and with `DynamicDimensions` otherwise. It must therefore be generic, typically a lambda taking an
+ * `auto` parameter, and return the same type for both.
+ *
+ * @return The value returned by `function`.
+ */
+template <typename Function>
+auto dispatchDimensions(int numberOfRounds, int numberOfTurns, int numberOfPlayers, int numberOfCells,
+                        Function &&function)
+{
+    if (ExperimentDimensions::matches(numberOfRounds, numberOfTurns, numberOfPlayers, numberOfCells))
+    {
+        return function(ExperimentDimensions{});
+    }
+    return function(DynamicDimensions{numberOfRounds, numberOfTurns, numberOfPlayers, numberOfCells});
+}
+
+#endif
@@ -1,91 +1,168 @@
-#include <algorithm> // std::all_of, std::any_of, std::fill, std::transform
+#include <algorithm> // std::any_of, std::binary_search, std::fill, std::inplace_merge, std::remove, std::remove_if, std::sort, std::unique
+#include <atomic>    // std::memory_order_acq_rel
 #include <cmath>     // std::isnan
-#include <fstream>   // std::ofstream
-#include <numeric>   // std::accumulate
+#include <memory>    // std::make_shared, std::shared_ptr
+#include <stdexcept> // std::invalid_argument
+#include <string>    // std::to_string
+#include <utility>   // std::move
 #include <vector>    // std::vector
 
+#include "game/ColorView.h"
 #include "game/Game.h"
+#include "game/GameObserver.h"
 #include "game/Map.h"
 #include "game/Rule.h"
+#include "game/Topology.h"
+#include "game/Validation.h"
 
-namespace
+Game::Game(int numberOfRounds,
+           int numberOfTurns,
+           int numberOfPlayers,
+           const Rule rule,
+           std::shared_ptr<const Map> map,
+           double tauEvaporation)
+    : Game(numberOfRounds, numberOfTurns, numberOfPlayers, rule, std::move(map), tauEvaporation, nullptr)
 {
-    // TODO: Change this legend parce que ce n'est pas vraiment la norme L1
-    /**
-     * @brief Normalize a vector by dividing each element by the sum of its elements.
-     *
-     * @note All elements of the vector must be non-negative.
-     *
-     * @param vector The vector to normalize.
-     * @return The normalized vector. If the sum of the input is 0, a vector of zeros of the same size is
-     *         returned.
-     */
-    template <typename T>
-    std::vector<double> normalize(const std::vector<T> &vector)
-    {
-        const double sum{std::accumulate(vector.begin(), vector.end(), 0.)};
-
-        if (sum == 0.)
-        {
-            return std::vector<double>(vector.size(), 0.);
-        }
-
-        std::vector<double> normalizedVector(vector.size());
-        std::transform(vector.begin(), vector.end(), normalizedVector.begin(),
-                       [sum](const T &value)
-                       { return static_cast<double>(value) / sum; });
-        return normalizedVector;
-    }
-} // namespace
+}
 
 Game::Game(int numberOfRounds,
            int numberOfTurns,
            int numberOfPlayers,
            const Rule rule,
-           const Map map,
-           double tauEvaporation)
+           std::shared_ptr<const Map> map,
+           double tauEvaporation,
+           std::shared_ptr<const Topology> topology)
     : //
       m_numberOfRounds{numberOfRounds},
       m_numberOfTurns{numberOfTurns},
       m_numberOfPlayers{numberOfPlayers},
       m_rule{rule},
-      m_map{map},
       m_tauEvaporation{tauEvaporation},
+      mp_topology{std::move(topology)},
+      //
+      mp_map{std::move(map)},
       //
       m_playerCount{0},
       //
       m_iRound{0},
-      m_rMap(m_map.getNumberOfCells(), 0.),
-      m_colors(m_map.getNumberOfCells(), 0.),
-      m_scores(m_map.getNumberOfCells(), 0),
-      m_iCellOpened{std::vector<std::vector<std::vector<int>>>(
-          m_numberOfPlayers, std::vector<std::vector<int>>(m_numberOfRounds, std::vector<int>(numberOfTurns, 0)))},
-      m_vCellOpened{std::vector<std::vector<std::vector<int>>>(
-          m_numberOfPlayers, std::vector<std::vector<int>>(m_numberOfRounds, std::vector<int>(numberOfTurns, 0)))},
-      m_rCellOpened{std::vector<std::vector<std::vector<int>>>(
-          m_numberOfPlayers, std::vector<std::vector<int>>(m_numberOfRounds, std::vector<int>(numberOfTurns, 0)))},
+      m_rMap(mp_map->getNumberOfCells(), 0.),
+      m_occupiedCells{},
+      m_newOccupiedCells{},
+      m_cellsByStars{},
+      m_ratedCells{},
+      m_sumOfStars{0.},
+      m_evaporationScale{1.},
+      m_hasIntegerStars{true},
+      m_smoothedStars(mp_topology ? mp_topology->getNumberOfCells() : 0, 0.),
+      m_scores(m_numberOfPlayers, 0),
+      m_roundScores(m_numberOfPlayers, 0),
+      m_history{m_numberOfPlayers, m_numberOfRounds, m_numberOfTurns},
       m_iTurn{std::vector<int>(numberOfPlayers, 0)},
-      m_hasOpenedACell{std::vector<bool>(numberOfPlayers, false)},
-      m_numberOfRatingsRemaining{std::vector<int>(numberOfPlayers, m_rule.getMaxRatingPerRound())}
+      m_hasOpenedACell(numberOfPlayers, false),
+      m_numberOfRatingsRemaining{std::vector<int>(numberOfPlayers, m_rule.getMaxRatingPerRound())},
+      m_numberOfPlayersDone{0},
+      //
+      m_observers{}
 {
+    if (mp_topology && mp_topology->getNumberOfCells() != mp_map->getNumberOfCells())
+    {
+        throw std::invalid_argument("The topology and the map must have the same number of cells.");
+    }
 }
 
 Game::Game(int numberOfRounds, int numberOfPlayers, const Rule &rule, double tauEvaporation)
-    : Game(numberOfRounds, 3, numberOfPlayers, rule, Map(225, false), tauEvaporation)
+    : Game(numberOfRounds, 3, numberOfPlayers, rule, Map::getShared(225), tauEvaporation)
 {
 }
 
 Game::Game(int numberOfRounds, int numberOfPlayers, const Rule &rule)
-    : Game(numberOfRounds, 3, numberOfPlayers, rule, Map(225, false), std::nan(""))
+    : Game(numberOfRounds, 3, numberOfPlayers, rule, Map::getShared(225), std::nan(""))
 {
 }
 
 Game::Game(int numberOfRounds, int numberOfPlayers)
-    : Game(numberOfRounds, 3, numberOfPlayers, Rule(RuleNumber::Rule2), Map(225, false), std::nan(""))
+    : Game(numberOfRounds, 3, numberOfPlayers, Rule(RuleNumber::Rule2), Map::getShared(225), std::nan(""))
 {
 }
 
+Game::Game(const Snapshot &snapshot)
+    : Game(snapshot.m_numberOfRounds, snapshot.m_numberOfTurns, snapshot.m_numberOfPlayers, snapshot.m_rule,
+           snapshot.mp_map, snapshot.m_tauEvaporation, snapshot.mp_topology)
+{
+    restore(snapshot);
+}
+
+template <typename Validation>
 int Game::openCell(int iPlayer, int iCell)
+{
+    if constexpr (Validation::enabled)
+    {
+        checkOpening(iPlayer, iCell);
+    }
+
+    m_hasOpenedACell[iPlayer] = true;
+
+    const int vCell{mp_map->getValue(iCell)};
+
+    m_history.recordOpening(iPlayer, m_iRound, m_iTurn[iPlayer], iCell, vCell);
+    for (GameObserver *observer : m_observers)
+    {
+        observer->onCellOpened(*this, iPlayer, iCell, vCell);
+    }
+    return vCell;
+}
+
+template <typename Validation>
+void Game::rateCell(int iPlayer, int rating)
+{
+    visitRule(m_rule.getRuleNumber(),
+              [this, iPlayer, rating](auto rule) { rateCell<Validation, decltype(rule)>(iPlayer, rating); });
+}
+
+template <typename Validation, typename RulePolicy>
+void Game::rateCell(int iPlayer, int rating)
+{
+    if constexpr (Validation::enabled)
+    {
+        if (RulePolicy::ruleNumber != m_rule.getRuleNumber())
+        {
+            throw GameException("Game::rateCell: The scoring policy is not the one of the rule of the game.");
+        }
+        checkRating(iPlayer, rating);
+    }
+
+    m_history.recordRating(iPlayer, m_iRound, m_iTurn[iPlayer], rating);
+
+    const int vCell{m_history.getValue(iPlayer, m_iRound, m_iTurn[iPlayer])};
+    m_roundScores[iPlayer] += RulePolicy::scoreOfTurn(vCell, rating);
+    m_numberOfRatingsRemaining[iPlayer] -= rating;
+    m_hasOpenedACell[iPlayer] = false;
+    for (GameObserver *observer : m_observers)
+    {
+        observer->onCellRated(*this, iPlayer, m_history.getCell(iPlayer, m_iRound, m_iTurn[iPlayer]), vCell, rating);
+    }
+    ++m_iTurn[iPlayer];
+
+    if (m_iTurn[iPlayer] == m_numberOfTurns && finishTheRoundOfAPlayer())
+    {
+        changeRound<RulePolicy>();
+    }
+}
+
+template int Game::openCell<CheckedValidation>(int iPlayer, int iCell);
+template int Game::openCell<UncheckedValidation>(int iPlayer, int iCell);
+template void Game::rateCell<CheckedValidation>(int iPlayer, int rating);
+template void Game::rateCell<UncheckedValidation>(int iPlayer, int rating);
+template void Game::rateCell<CheckedValidation, Rule1>(int iPlayer, int rating);
+template void Game::rateCell<CheckedValidation, Rule2>(int iPlayer, int rating);
+template void Game::rateCell<CheckedValidation, Rule3>(int iPlayer, int rating);
+template void Game::rateCell<CheckedValidation, Rule4>(int iPlayer, int rating);
+template void Game::rateCell<UncheckedValidation, Rule1>(int iPlayer, int rating);
+template void Game::rateCell<UncheckedValidation, Rule2>(int iPlayer, int rating);
+template void Game::rateCell<UncheckedValidation, Rule3>(int iPlayer, int rating);
+template void Game::rateCell<UncheckedValidation, Rule4>(int iPlayer, int rating);
+
+void Game::checkOpening(int iPlayer, int iCell) const
 {
     if (m_iRound >= m_numberOfRounds)
     {
@@ -101,7 +178,7 @@ int Game::openCell(int iPlayer, int iCell)
         throw GameException("Game::openCell: Player " + std::to_string(iPlayer) +
                             " already opened a cell and must rate it before opening another cell.");
     }
-    if (!m_map.isValidIndex(iCell))
+    if (!mp_map->isValidIndex(iCell))
     {
         throw GameException("Game::openCell: The cell number " + std::to_string(iCell) + " does not exist.");
     }
@@ -110,17 +187,9 @@ int Game::openCell(int iPlayer, int iCell)
         throw GameException("Game::openCell: The player " + std::to_string(iPlayer) + " already opened the cell " +
                             std::to_string(iCell) + " during the round.");
     }
-
-    m_hasOpenedACell[iPlayer] = true;
-
-    const int vCell{m_map.getValue(iCell)};
-
-    m_iCellOpened[iPlayer][m_iRound][m_iTurn[iPlayer]] = iCell;
-    m_vCellOpened[iPlayer][m_iRound][m_iTurn[iPlayer]] = vCell;
-    return vCell;
 }
 
-void Game::rateCell(int iPlayer, int rating)
+void Game::checkRating(int iPlayer, int rating) const
 {
     if (m_iRound >= m_numberOfRounds)
     {
@@ -148,75 +217,266 @@ void Game::rateCell(int iPlayer, int rating)
         throw GameException("Game::rateCell: Player " + std::to_string(iPlayer) + " only has " +
                             std::to_string(m_numberOfRatingsRemaining[iPlayer]) + " ratings remaining.");
     }
+}
 
-    m_rCellOpened[iPlayer][m_iRound][m_iTurn[iPlayer]] = rating;
+void Game::reset()
+{
+    clear();
+    notifyReset();
+}
 
-    m_numberOfRatingsRemaining[iPlayer] -= rating;
-    m_hasOpenedACell[iPlayer] = false;
-    ++m_iTurn[iPlayer];
+void Game::clear()
+{
+    m_playerCount = 0;
+    m_iRound = 0;
+    // Only the occupied cells hold stars, so that resetting a large map does not touch all its cells
+    clearSmoothedStars();
+    for (const int iCell : m_occupiedCells)
+    {
+        m_rMap[iCell] = 0.;
+    }
+    m_occupiedCells.clear();
+    m_cellsByStars.clear();
+    m_sumOfStars = 0.;
+    m_evaporationScale = 1.;
+    m_hasIntegerStars = true;
+    std::fill(m_scores.begin(), m_scores.end(), 0);
+    std::fill(m_roundScores.begin(), m_roundScores.end(), 0);
+    m_history.clear();
+    std::fill(m_iTurn.begin(), m_iTurn.end(), 0);
+    std::fill(m_hasOpenedACell.begin(), m_hasOpenedACell.end(), false);
+    std::fill(m_numberOfRatingsRemaining.begin(), m_numberOfRatingsRemaining.end(), m_rule.getMaxRatingPerRound());
+    m_numberOfPlayersDone = 0;
+}
+
+void Game::reset(std::shared_ptr<const Map> map)
+{
+    if (map->getNumberOfCells() != mp_map->getNumberOfCells())
+    {
+        throw std::invalid_argument("The map must have the same number of cells as the map of the game.");
+    }
+    mp_map = std::move(map);
+    clear();
+    notifyReset();
+}
+
+void Game::notifyReset()
+{
+    for (GameObserver *observer : m_observers)
+    {
+        observer->onGameReset(*this);
+    }
+}
 
-    if (haveAllPlayersPlayedTheirTurns())
+Game::Snapshot Game::takeSnapshot() const
+{
+    if (std::any_of(m_iTurn.begin(), m_iTurn.end(), [](int iTurn) { return iTurn != 0; }) ||
+        std::any_of(m_hasOpenedACell.begin(), m_hasOpenedACell.end(), [](char hasOpened) { return hasOpened; }))
     {
-        changeRound();
+        throw GameException("Game::takeSnapshot: The round " + std::to_string(m_iRound) + " is being played.");
     }
+
+    // The rounds played are copied once here, then shared by all the games restored from the snapshot
+    return {*this, std::make_shared<const GameHistory>(m_history)};
 }
 
+void Game::restore(const Snapshot &snapshot)
+{
+    if (snapshot.m_numberOfRounds != m_numberOfRounds || snapshot.m_numberOfTurns != m_numberOfTurns ||
+        snapshot.m_numberOfPlayers != m_numberOfPlayers ||
+        snapshot.mp_map->getNumberOfCells() != mp_map->getNumberOfCells() || snapshot.mp_topology != mp_topology)
+    {
+        throw GameException("Game::restore: The snapshot was taken from a game of other dimensions, number of cells "
+                            "or topology.");
+    }
+
+    clear();
+    mp_map = snapshot.mp_map;
+    m_iRound = snapshot.m_iRound;
+    for (int iOccupied{0}; iOccupied < snapshot.m_occupiedCells.size(); ++iOccupied)
+    {
+        m_rMap[snapshot.m_occupiedCells[iOccupied]] = snapshot.m_stars[iOccupied];
+        addSmoothedStars(snapshot.m_occupiedCells[iOccupied], snapshot.m_stars[iOccupied]);
+    }
+    m_occupiedCells = snapshot.m_occupiedCells;
+    m_cellsByStars = snapshot.m_cellsByStars;
+    m_sumOfStars = snapshot.m_sumOfStars;
+    m_evaporationScale = snapshot.m_evaporationScale;
+    m_hasIntegerStars = snapshot.m_hasIntegerStars;
+    m_scores = snapshot.m_scores;
+    m_history.sharePrefix(snapshot.mp_history, snapshot.m_iRound);
+    notifyReset();
+}
+
+template <typename RulePolicy>
 void Game::changeRound()
 {
     updateColors();
-    updateScores();
+    updateScores<RulePolicy>();
 
     std::fill(m_iTurn.begin(), m_iTurn.end(), 0);
     std::fill(m_numberOfRatingsRemaining.begin(), m_numberOfRatingsRemaining.end(), m_rule.getMaxRatingPerRound());
+    m_numberOfPlayersDone = 0;
 
     ++m_iRound;
+    for (GameObserver *observer : m_observers)
+    {
+        observer->onRoundChanged(*this, m_iRound - 1);
+    }
 }
 
 void Game::updateColors()
 {
+    // The evaporation of all the cells is applied lazily through a common scale factor: the actual number of
+    // stars of a cell is `m_rMap[iCell] * m_evaporationScale`, so that new stars are added divided by the scale
     if (!std::isnan(m_tauEvaporation))
     {
-        const double evaporationFactor{1. - 1. / m_tauEvaporation};
-        for (double &value : m_rMap)
+        m_hasIntegerStars = false;
+        m_evaporationScale *= 1. - 1. / m_tauEvaporation;
+        if (m_evaporationScale < minEvaporationScale)
         {
-            value *= evaporationFactor;
+            rescaleStars();
         }
     }
 
+    // Only the cells rated during the round change; the colors are derived from the stars on access
     for (int iPlayer{0}; iPlayer < m_numberOfPlayers; ++iPlayer)
     {
+        const GameHistory::RoundView round{m_history.getRound(iPlayer, m_iRound)};
         for (int iTurn{0}; iTurn < m_numberOfTurns; ++iTurn)
         {
-            const int iCell{m_iCellOpened[iPlayer][m_iRound][iTurn]};
-            const int rating{m_rCellOpened[iPlayer][m_iRound][iTurn]};
-            m_rMap[iCell] += rating;
+            const int iCell{round.getCell(iTurn)};
+            const double stars{round.getRating(iTurn) / m_evaporationScale};
+            if (m_rMap[iCell] == 0. && stars > 0.)
+            {
+                m_newOccupiedCells.push_back(iCell);
+            }
+            if (stars > 0.)
+            {
+                m_ratedCells.push_back(iCell);
+            }
+            m_rMap[iCell] += stars;
+            m_sumOfStars += stars;
+            addSmoothedStars(iCell, stars);
+        }
+    }
+
+    // The few cells occupied during the round are merged into the sorted occupied cells
+    if (!m_newOccupiedCells.empty())
+    {
+        std::sort(m_newOccupiedCells.begin(), m_newOccupiedCells.end());
+        const auto middle{m_occupiedCells.insert(m_occupiedCells.end(), m_newOccupiedCells.begin(),
+                                                 m_newOccupiedCells.end())};
+        std::inplace_merge(m_occupiedCells.begin(), middle, m_occupiedCells.end());
+        m_newOccupiedCells.clear();
+    }
+
+    updateCellsByStars();
+}
+
+void Game::updateCellsByStars()
+{
+    // Only the cells rated during the round have changed: they are taken out of the cells sorted by stars,
+    // whose order is unchanged, and merged back at their new place. The evaporation scales all the stars by
+    // the same factor, so it does not change the order.
+    std::sort(m_ratedCells.begin(), m_ratedCells.end());
+    m_ratedCells.erase(std::unique(m_ratedCells.begin(), m_ratedCells.end()), m_ratedCells.end());
+    m_cellsByStars.erase(std::remove_if(m_cellsByStars.begin(), m_cellsByStars.end(),
+                                        [this](int iCell)
+                                        { return std::binary_search(m_ratedCells.begin(), m_ratedCells.end(), iCell); }),
+                         m_cellsByStars.end());
+
+    const auto byStars{[this](int iCell1, int iCell2) { return hasMoreStars(iCell1, iCell2); }};
+    std::sort(m_ratedCells.begin(), m_ratedCells.end(), byStars);
+    const auto middle{m_cellsByStars.insert(m_cellsByStars.end(), m_ratedCells.begin(), m_ratedCells.end())};
+    std::inplace_merge(m_cellsByStars.begin(), middle, m_cellsByStars.end(), byStars);
+    m_ratedCells.clear();
+}
+
+bool Game::hasMoreStars(int iCell1, int iCell2) const
+{
+    return m_rMap[iCell1] > m_rMap[iCell2] || (m_rMap[iCell1] == m_rMap[iCell2] && iCell1 < iCell2);
+}
+
+void Game::rescaleStars()
+{
+    clearSmoothedStars();
+    for (const int iCell : m_occupiedCells)
+    {
+        m_rMap[iCell] *= m_evaporationScale;
+    }
+    m_sumOfStars *= m_evaporationScale;
+
+    // The stars of a cell may have evaporated completely, e.g. for tau = 1
+    m_occupiedCells.erase(std::remove_if(m_occupiedCells.begin(), m_occupiedCells.end(),
+                                         [this](int iCell) { return m_rMap[iCell] == 0.; }),
+                          m_occupiedCells.end());
+    m_cellsByStars.erase(std::remove_if(m_cellsByStars.begin(), m_cellsByStars.end(),
+                                        [this](int iCell) { return m_rMap[iCell] == 0.; }),
+                         m_cellsByStars.end());
+    m_evaporationScale = 1.;
+    for (const int iCell : m_occupiedCells)
+    {
+        addSmoothedStars(iCell, m_rMap[iCell]);
+    }
+}
+
+void Game::addSmoothedStars(int iCell, double stars)
+{
+    if (mp_topology)
+    {
+        m_smoothedStars[iCell] += stars;
+        for (const int iNeighbour : mp_topology->getNeighbours(iCell))
+        {
+            m_smoothedStars[iNeighbour] += stars;
+        }
+    }
+}
+
+void Game::clearSmoothedStars()
+{
+    if (mp_topology)
+    {
+        for (const int iCell : m_occupiedCells)
+        {
+            m_smoothedStars[iCell] = 0.;
+            for (const int iNeighbour : mp_topology->getNeighbours(iCell))
+            {
+                m_smoothedStars[iNeighbour] = 0.;
+            }
         }
     }
-    m_colors = normalize(m_rMap);
 }
 
+template <typename RulePolicy>
 void Game::updateScores()
 {
+    // The scores of the turns were accumulated as the cells were rated; only the unspent stars remain
     for (int iPlayer{0}; iPlayer < m_numberOfPlayers; ++iPlayer)
     {
-        m_scores[iPlayer] += m_rule.calculateScore(m_vCellOpened[iPlayer][m_iRound], m_rCellOpened[iPlayer][m_iRound]);
+        m_scores[iPlayer] += m_roundScores[iPlayer];
+        m_scores[iPlayer] += RulePolicy::scoreOfRemainingRatings(m_numberOfRatingsRemaining[iPlayer]);
+        m_roundScores[iPlayer] = 0;
     }
 }
 
 bool Game::hasThePlayerOpenedTheCellDuringTheRound(int iPlayer, int iCell) const
 {
-    return std::any_of(m_iCellOpened[iPlayer][m_iRound].begin(),
-                       m_iCellOpened[iPlayer][m_iRound].begin() + m_iTurn[iPlayer],
-                       [iCell](int iCellOpened)
-                       { return iCellOpened == iCell; });
+    const GameHistory::RoundView cellsPlayed{getCellsPlayedDuringTheRound(iPlayer)};
+    for (int iTurn{0}; iTurn < cellsPlayed.size(); ++iTurn)
+    {
+        if (cellsPlayed.getCell(iTurn) == iCell)
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
-bool Game::haveAllPlayersPlayedTheirTurns() const
+bool Game::finishTheRoundOfAPlayer()
 {
-    return std::all_of(m_iTurn.begin(),
-                       m_iTurn.end(),
-                       [&numberOfTurns = m_numberOfTurns](int iTurn)
-                       { return iTurn == numberOfTurns; });
+    // The last player to finish sees the moves of all the others, which were released by their increments
+    return m_numberOfPlayersDone.fetch_add(1, std::memory_order_acq_rel) + 1 == m_numberOfPlayers;
 }
 
 Game *Game::getAddress()
@@ -224,14 +484,67 @@ Game *Game::getAddress()
     return this;
 }
 
+void Game::addObserver(GameObserver &observer)
+{
+    m_observers.push_back(&observer);
+}
+
+void Game::removeObserver(GameObserver &observer)
+{
+    m_observers.erase(std::remove(m_observers.begin(), m_observers.end(), &observer), m_observers.end());
+}
+
 int Game::registerPlayer()
 {
     return m_playerCount++;
 }
 
-const std::vector<double> &Game::getColors() const
+Game::Snapshot::Snapshot(const Game &game, std::shared_ptr<const GameHistory> history)
+    : //
+      m_numberOfRounds{game.m_numberOfRounds},
+      m_numberOfTurns{game.m_numberOfTurns},
+      m_numberOfPlayers{game.m_numberOfPlayers},
+      m_rule{game.m_rule},
+      mp_map{game.mp_map},
+      m_tauEvaporation{game.m_tauEvaporation},
+      mp_topology{game.mp_topology},
+      //
+      m_iRound{game.m_iRound},
+      m_occupiedCells{game.m_occupiedCells},
+      m_stars(game.m_occupiedCells.size()),
+      m_cellsByStars{game.m_cellsByStars},
+      m_sumOfStars{game.m_sumOfStars},
+      m_evaporationScale{game.m_evaporationScale},
+      m_hasIntegerStars{game.m_hasIntegerStars},
+      m_scores{game.m_scores},
+      mp_history{std::move(history)}
+{
+    // Only the occupied cells hold stars, so that the snapshot of a large map stays small
+    for (int iOccupied{0}; iOccupied < m_occupiedCells.size(); ++iOccupied)
+    {
+        m_stars[iOccupied] = game.m_rMap[m_occupiedCells[iOccupied]];
+    }
+}
+
+int Game::Snapshot::getCurrentRound() const
 {
-    return m_colors;
+    return m_iRound;
+}
+
+ColorView Game::getColors() const
+{
+    return {m_rMap, m_occupiedCells, m_cellsByStars, m_sumOfStars, m_evaporationScale, m_hasIntegerStars,
+            mp_topology.get(), &m_smoothedStars};
+}
+
+const GameHistory &Game::getHistory() const
+{
+    return m_history;
+}
+
+GameHistory::RoundView Game::getCellsPlayedDuringTheRound(int iPlayer) const
+{
+    return m_history.getRound(iPlayer, m_iRound, m_iTurn[iPlayer]);
 }
 
 int Game::getScoreOfPlayer(int iPlayer) const
@@ -239,11 +552,21 @@ int Game::getScoreOfPlayer(int iPlayer) const
     return m_scores[iPlayer];
 }
 
+const std::vector<int> &Game::getScores() const
+{
+    return m_scores;
+}
+
 int Game::getCurrentRound() const
 {
     return m_iRound;
 }
 
+int Game::getNumberOfPlayers() const
+{
+    return m_numberOfPlayers;
+}
+
 int Game::getNumberOfRounds() const
 {
     return m_numberOfRounds;
@@ -256,5 +579,15 @@ int Game::getNumberOfTurns() const
 
 int Game::getNumberOfCells() const
 {
-    return m_map.getNumberOfCells();
+    return mp_map->getNumberOfCells();
+}
+
+const Map &Game::getMap() const
+{
+    return *mp_map;
+}
+
+const Rule &Game::getRule() const
+{
+    return m_rule;
 }
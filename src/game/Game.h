@@ -1,48 +1,179 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <atomic>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "game/ColorView.h"
+#include "game/GameHistory.h"
+#include "game/GameObserver.h"
 #include "game/Map.h"
 #include "game/Rule.h"
+#include "game/Topology.h"
+#include "game/Validation.h"
 
-class GameAnalyzer;
-
+/**
+ * @brief A game of stigmergy: the players open cells of a shared map and rate them with stars.
+ *
+ * The state of each player during a round (its turn, its history, its round score and its remaining stars)
+ * is stored in its own slot, and the end of the round is detected by counting the players who have played
+ * all their turns. The players of a game may thus play a round concurrently, each from its own thread, as
+ * long as each player only plays its own moves: the last player to finish merges the colors and the scores
+ * of the round when the game changes round. This allows games with thousands of players, see
+ * `Agent::playARoundInParallel`.
+ *
+ * Between two rounds, the state of a game can be saved into a `Snapshot`, from which any number of
+ * continuations can be forked, see `restore`.
+ */
 class Game
 {
-    friend class GameAnalyzer;
-
 public:
-    Game(int numberOfRounds, int numberOfTurns, int numberOfPlayers, const Rule rule, const Map map,
+    class Snapshot;
+
+    /**
+     * @brief Build a game played on a shared map.
+     *
+     * @param numberOfRounds Number of rounds.
+     * @param numberOfTurns Number of turns per round.
+     * @param numberOfPlayers Number of players.
+     * @param rule The scoring rule.
+     * @param map The map, shared with other games. Must not be null.
+     * @param tauEvaporation Evaporation time of the ratings, or NaN for no evaporation.
+     */
+    Game(int numberOfRounds, int numberOfTurns, int numberOfPlayers, const Rule rule, std::shared_ptr<const Map> map,
          double tauEvaporation);
 
+    /**
+     * @brief Build a game played on a shared map arranged on a grid.
+     *
+     * The stars of the neighbourhood of each cell are maintained as the stars are given, at a cost
+     * proportional to the size of the neighbourhoods, so that the strategies can use the smoothed colors of
+     * `ColorView`.
+     *
+     * @param topology The arrangement of the cells of the map, shared with other games, or null for none.
+     *        Must have as many cells as the map.
+     */
+    Game(int numberOfRounds, int numberOfTurns, int numberOfPlayers, const Rule rule, std::shared_ptr<const Map> map,
+         double tauEvaporation, std::shared_ptr<const Topology> topology);
+
     Game(int numberOfRounds, int numberOfPlayers, const Rule &rule, double tauEvaporation);
 
     Game(int numberOfRounds, int numberOfPlayers, const Rule &rule);
 
     Game(int numberOfRounds, int numberOfPlayers);
 
+    /**
+     * @brief Build a game forked from a snapshot, with the same dimensions, rule, map, evaporation and topology.
+     *
+     * @param snapshot The snapshot, see `restore`.
+     */
+    explicit Game(const Snapshot &snapshot);
+
     /**
      * @brief Open a cell for a given player.
      *
+     * @tparam Validation `CheckedValidation` to throw a `GameException` on invalid moves, or
+     *         `UncheckedValidation` to skip the checks for trusted callers.
      * @param playerId The identifier of the player.
      * @param iCell The index of the cell to open.
      * @return The value of the cell.
      */
+    template <typename Validation = CheckedValidation>
     int openCell(int playerId, int iCell);
 
     /**
      * @brief Rate the cell that was just opened by the given player.
      *
+     * The scoring policy of the rule is looked up at each call; callers playing many turns should dispatch
+     * the rule once with `visitRule` and call the overload taking the policy.
+     *
+     * @tparam Validation `CheckedValidation` to throw a `GameException` on invalid moves, or
+     *         `UncheckedValidation` to skip the checks for trusted callers.
+     * @param playerId The identifier of the player.
+     * @param numberOfRatings The number of stars to assign to the cell.
+     */
+    template <typename Validation = CheckedValidation>
+    void rateCell(int playerId, int numberOfRatings);
+
+    /**
+     * @brief Rate the cell that was just opened by the given player, scoring the turn with a policy known at
+     * compile time.
+     *
+     * @tparam Validation `CheckedValidation` to throw a `GameException` on invalid moves, including a policy
+     *         that is not the one of the rule of the game, or `UncheckedValidation` to skip the checks.
+     * @tparam RulePolicy The scoring policy of the rule of the game, see `visitRule`.
      * @param playerId The identifier of the player.
      * @param numberOfRatings The number of stars to assign to the cell.
      */
+    template <typename Validation, typename RulePolicy>
     void rateCell(int playerId, int numberOfRatings);
 
+    /**
+     * @brief Restore the game to its initial state so that it can be played again.
+     *
+     * The colors, scores and history are cleared in place without reallocating. Players must register
+     * again, typically through `Agent::assignToGame`.
+     */
+    void reset();
+
+    /**
+     * @brief Restore the game to its initial state, to play it again on another map.
+     *
+     * Only the pointer to the map is replaced, so that each game of a simulation can be played on its own
+     * map, e.g. drawn from a `MapPool`, at the cost of a plain `reset`.
+     *
+     * @param map The map of the next game, with the same number of cells as the current one.
+     * @throws std::invalid_argument If the map does not have the same number of cells.
+     */
+    void reset(std::shared_ptr<const Map> map);
+
+    /**
+     * @brief Save the state of the game between two rounds, to fork continuations of the game from it.
+     *
+     * The rounds already played are copied once into the snapshot, and shared by all the games restored
+     * from it.
+     *
+     * @return The snapshot of the game.
+     * @throws GameException If a player has already played during the current round.
+     */
+    [[nodiscard]] Snapshot takeSnapshot() const;
+
+    /**
+     * @brief Restore the game to the state of a snapshot, to play a continuation of the game it was taken from.
+     *
+     * As with `reset`, the storage of the game is reused, and the players must register again in the same
+     * order, typically through `Agent::assignToGame`. The history of the rounds of the snapshot is shared
+     * rather than copied, and only the colors and the scores are copied, so that forking a game is cheap. The
+     * rule and the evaporation of the game are kept, so that a continuation may use other ones, while the map
+     * of the snapshot is adopted, so that a game may fork continuations of games played on other maps.
+     *
+     * @param snapshot The snapshot, taken from a game of the same dimensions, number of cells and topology.
+     * @throws GameException If the snapshot was taken from a game of other dimensions, number of cells or
+     *         topology.
+     */
+    void restore(const Snapshot &snapshot);
+
     Game *getAddress();
 
+    /**
+     * @brief Send the events of the game to an observer, e.g. to analyze the game while it is played.
+     *
+     * The observer stays attached when the game is reset, and must outlive the game or be removed.
+     *
+     * @param observer The observer, notified after the observers added before it.
+     */
+    void addObserver(GameObserver &observer);
+
+    /**
+     * @brief Stop sending the events of the game to an observer.
+     *
+     * @param observer The observer, which must have been added.
+     */
+    void removeObserver(GameObserver &observer);
+
     /**
      * @brief Assign a unique identifier to a player.
      *
@@ -52,34 +183,125 @@ public:
      */
     int registerPlayer();
 
-    [[nodiscard]] const std::vector<double> &getColors() const;
+    /**
+     * @brief Get the colors of the map, i.e. the fraction of all the stars held by each cell.
+     *
+     * @return A view of the colors, valid until the next change of round.
+     */
+    [[nodiscard]] ColorView getColors() const;
+
+    /**
+     * @brief Get the record of all the cells opened and rated so far.
+     *
+     * @return A reference to the history of the game.
+     */
+    [[nodiscard]] const GameHistory &getHistory() const;
+
+    /**
+     * @brief Get the cells opened by a player since the start of the current round.
+     *
+     * @param playerId The identifier of the player.
+     * @return A view whose size is the number of turns already played by the player during the round.
+     */
+    [[nodiscard]] GameHistory::RoundView getCellsPlayedDuringTheRound(int playerId) const;
 
     [[nodiscard]] int getScoreOfPlayer(int playerId) const;
 
+    /**
+     * @brief Get the scores of all the players, indexed by player identifier.
+     */
+    [[nodiscard]] const std::vector<int> &getScores() const;
+
     [[nodiscard]] int getCurrentRound() const;
 
+    [[nodiscard]] int getNumberOfPlayers() const;
+
     [[nodiscard]] int getNumberOfRounds() const;
 
     [[nodiscard]] int getNumberOfTurns() const;
 
     [[nodiscard]] int getNumberOfCells() const;
 
+    [[nodiscard]] const Map &getMap() const;
+
+    [[nodiscard]] const Rule &getRule() const;
+
 private:
     /**
      * @brief Advance to the next round and update the distributions and scores.
+     *
+     * @tparam RulePolicy The scoring policy of the rule of the game.
      */
+    template <typename RulePolicy>
     void changeRound();
 
     /**
-     * @brief Update the color map used by players.
+     * @brief Add the stars given during the round to the star map and its running sum.
      */
     void updateColors();
 
     /**
-     * @brief Update the scores of the players.
+     * @brief Fold the evaporation scale factor into the star map, to keep the stored stars from overflowing.
+     */
+    void rescaleStars();
+
+    /**
+     * @brief Add stars to the stars of the neighbourhoods that contain a cell, i.e. the cell and its neighbours.
+     *
+     * @param iCell The index of the cell.
+     * @param stars The stars added to the cell.
+     */
+    void addSmoothedStars(int iCell, double stars);
+
+    /**
+     * @brief Set the stars of the neighbourhoods of the occupied cells to 0.
+     */
+    void clearSmoothedStars();
+
+    /**
+     * @brief Move the cells rated during the round to their new place in the cells sorted by stars.
+     */
+    void updateCellsByStars();
+
+    /**
+     * @brief Check if a cell holds more stars than another one, or as many and a lower index.
+     */
+    bool hasMoreStars(int iCell1, int iCell2) const;
+
+    /**
+     * @brief Commit the scores of the round to the scores of the players.
+     *
+     * @tparam RulePolicy The scoring policy of the rule of the game.
      */
+    template <typename RulePolicy>
     void updateScores();
 
+    /**
+     * @brief Clear the colors, scores, history and round state of the game, see `reset`.
+     */
+    void clear();
+
+    /**
+     * @brief Tell the observers that the game has been reset or restored.
+     */
+    void notifyReset();
+
+    /**
+     * @brief Throw a `GameException` if the player may not open the cell.
+     *
+     * @param playerId The identifier of the player.
+     * @param iCell The index of the cell.
+     */
+    void checkOpening(int playerId, int iCell) const;
+
+    /**
+     * @brief Throw a `GameException` if the player may not give the rating.
+     *
+     * @param playerId The identifier of the player.
+     * @param numberOfRatings The number of stars.
+     */
+    void checkRating(int playerId, int numberOfRatings) const;
+
     /**
      * @brief Check if a player has already opened a given cell during the current round.
      *
@@ -90,32 +312,85 @@ private:
     bool hasThePlayerOpenedTheCellDuringTheRound(int playerId, int iCell) const;
 
     /**
-     * @brief Check if all players have played their turns for the current round.
+     * @brief Record that a player has played all its turns of the round.
      *
-     * @return `true` if all players have played their turns.
+     * @return `true` if the player was the last one, so that the round is over.
      */
-    bool haveAllPlayersPlayedTheirTurns() const;
+    bool finishTheRoundOfAPlayer();
+
+    // Below this evaporation scale, the star map is rescaled (after about 660 rounds for tau = 2)
+    static constexpr double minEvaporationScale{1e-200};
 
     // Constant variables
     const int m_numberOfRounds;
     const int m_numberOfTurns;
     const int m_numberOfPlayers;
     const Rule m_rule;
-    const Map m_map;
     const double m_tauEvaporation;
+    const std::shared_ptr<const Topology> mp_topology;
+    // Map, which may change between two games
+    std::shared_ptr<const Map> mp_map;
     // Player count
     int m_playerCount;
     // Variables updated at each round
     int m_iRound;
     std::vector<double> m_rMap;
-    std::vector<double> m_colors;
+    std::vector<int> m_occupiedCells;
+    std::vector<int> m_newOccupiedCells;
+    // Occupied cells sorted by decreasing stars, and the cells rated during the round
+    std::vector<int> m_cellsByStars;
+    std::vector<int> m_ratedCells;
+    double m_sumOfStars;
+    double m_evaporationScale;
+    // No evaporation has been applied since the start of the game, so that the stars are integers
+    bool m_hasIntegerStars;
+    // Stars of each cell and its neighbours, if the game has a topology
+    std::vector<double> m_smoothedStars;
     std::vector<int> m_scores;
-    std::vector<std::vector<std::vector<int>>> m_iCellOpened;
-    std::vector<std::vector<std::vector<int>>> m_vCellOpened;
-    std::vector<std::vector<std::vector<int>>> m_rCellOpened;
+    std::vector<int> m_roundScores;
+    GameHistory m_history;
     std::vector<int> m_iTurn;
-    std::vector<bool> m_hasOpenedACell;
+    // One byte per player rather than a `std::vector<bool>`, so that the players can play concurrently
+    std::vector<char> m_hasOpenedACell;
     std::vector<int> m_numberOfRatingsRemaining;
+    std::atomic<int> m_numberOfPlayersDone;
+    // Observers of the game
+    std::vector<GameObserver *> m_observers;
+};
+
+/**
+ * @brief The state of a `Game` between two rounds, see `Game::takeSnapshot`.
+ *
+ * A snapshot is immutable, and may be restored concurrently by several threads.
+ */
+class Game::Snapshot
+{
+public:
+    [[nodiscard]] int getCurrentRound() const;
+
+private:
+    friend class Game;
+
+    Snapshot(const Game &game, std::shared_ptr<const GameHistory> history);
+
+    // Dimensions and parameters of the game
+    int m_numberOfRounds;
+    int m_numberOfTurns;
+    int m_numberOfPlayers;
+    Rule m_rule;
+    std::shared_ptr<const Map> mp_map;
+    double m_tauEvaporation;
+    std::shared_ptr<const Topology> mp_topology;
+    // State of the game at the start of the round
+    int m_iRound;
+    std::vector<int> m_occupiedCells;
+    std::vector<double> m_stars;
+    std::vector<int> m_cellsByStars;
+    double m_sumOfStars;
+    double m_evaporationScale;
+    bool m_hasIntegerStars;
+    std::vector<int> m_scores;
+    std::shared_ptr<const GameHistory> mp_history;
 };
 
 class GameException : public std::runtime_error
@@ -0,0 +1,98 @@
+#include <cstddef>
+#include <cstring> // std::memcpy, std::memset
+#include <memory>  // std::shared_ptr
+#include <new>     // std::align_val_t
+#include <utility> // std::move
+
+#include "game/GameHistory.h"
+
+namespace
+{
+    constexpr std::size_t cacheLineSize{64};
+
+    /**
+     * @brief Round a size up to the next multiple of the cache line size.
+     */
+    std::size_t alignToCacheLine(std::size_t size)
+    {
+        return (size + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+    }
+} // namespace
+
+GameHistory::GameHistory(int numberOfPlayers, int numberOfRounds, int numberOfTurns)
+    : m_numberOfPlayers{numberOfPlayers},
+      m_numberOfRounds{numberOfRounds},
+      m_numberOfTurns{numberOfTurns},
+      m_numberOfEntries{static_cast<std::size_t>(numberOfPlayers) * numberOfRounds * numberOfTurns},
+      m_bufferSize{alignToCacheLine(m_numberOfEntries * sizeof(CellIndex)) +
+                   alignToCacheLine(m_numberOfEntries * sizeof(CellValue)) +
+                   alignToCacheLine(m_numberOfEntries * sizeof(Rating))},
+      mp_prefix{},
+      m_numberOfPrefixRounds{0}
+{
+    allocate();
+}
+
+GameHistory::GameHistory(const GameHistory &other)
+    : m_numberOfPlayers{other.m_numberOfPlayers},
+      m_numberOfRounds{other.m_numberOfRounds},
+      m_numberOfTurns{other.m_numberOfTurns},
+      m_numberOfEntries{other.m_numberOfEntries},
+      m_bufferSize{other.m_bufferSize},
+      mp_prefix{other.mp_prefix},
+      m_numberOfPrefixRounds{other.m_numberOfPrefixRounds}
+{
+    allocate();
+    std::memcpy(m_buffer.get(), other.m_buffer.get(), m_bufferSize);
+}
+
+GameHistory &GameHistory::operator=(const GameHistory &other)
+{
+    if (this != &other)
+    {
+        if (m_bufferSize != other.m_bufferSize)
+        {
+            m_bufferSize = other.m_bufferSize;
+            m_numberOfEntries = other.m_numberOfEntries;
+            allocate();
+        }
+        m_numberOfPlayers = other.m_numberOfPlayers;
+        m_numberOfRounds = other.m_numberOfRounds;
+        m_numberOfTurns = other.m_numberOfTurns;
+        std::memcpy(m_buffer.get(), other.m_buffer.get(), m_bufferSize);
+        mp_prefix = other.mp_prefix;
+        m_numberOfPrefixRounds = other.m_numberOfPrefixRounds;
+    }
+    return *this;
+}
+
+void GameHistory::clear()
+{
+    std::memset(m_buffer.get(), 0, m_bufferSize);
+    mp_prefix.reset();
+    m_numberOfPrefixRounds = 0;
+}
+
+void GameHistory::sharePrefix(std::shared_ptr<const GameHistory> prefix, int numberOfRounds)
+{
+    mp_prefix = std::move(prefix);
+    m_numberOfPrefixRounds = numberOfRounds;
+}
+
+void GameHistory::allocate()
+{
+    m_buffer.reset(static_cast<std::byte *>(::operator new[](m_bufferSize, std::align_val_t{cacheLineSize})));
+    std::memset(m_buffer.get(), 0, m_bufferSize);
+
+    std::byte *plane{m_buffer.get()};
+    mp_cells = reinterpret_cast<CellIndex *>(plane);
+    plane += alignToCacheLine(m_numberOfEntries * sizeof(CellIndex));
+    mp_values = reinterpret_cast<CellValue *>(plane);
+    plane += alignToCacheLine(m_numberOfEntries * sizeof(CellValue));
+    mp_ratings = reinterpret_cast<Rating *>(plane);
+}
+
+void GameHistory::AlignedDeleter::operator()(std::byte *buffer) const
+{
+    ::operator delete[](buffer, std::align_val_t{cacheLineSize});
+}
@@ -0,0 +1,207 @@
+#ifndef GAME_HISTORY_H
+#define GAME_HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Record of every cell opened and rated during a game.
+ *
+ * The history is stored in a single cache-line-aligned allocation split into three planes (cell
+ * indices, cell values and ratings), each laid out as [player][round][turn]. Values and ratings use
+ * one byte per entry; cell indices use 32 bits so that large maps remain addressable.
+ *
+ * The width of the cell indices is not chosen from the size of the map: the size is only known at run time,
+ * and the same `Game`, `Agent` and `RoundView` serve the 225-cell maps as well as the large maps of the
+ * sparse exploration, so a narrower index would have to be a template parameter of all of them. The 32-bit
+ * plane of a game of 5 players, 20 rounds and 3 turns takes 1200 bytes against 300 for 8-bit indices, both
+ * of which stay in L1, which is not worth a second instantiation of the whole game.
+ *
+ * The first rounds of a history may be read from another history, shared by all the games forked from the
+ * same snapshot, see `sharePrefix`: the rounds played are never modified, so the prefix is shared rather
+ * than copied, and only the following rounds are written to the history itself.
+ */
+class GameHistory
+{
+public:
+    using CellIndex = std::int32_t;
+    using CellValue = std::uint8_t;
+    using Rating = std::uint8_t;
+
+    /**
+     * @brief Read-only view of the turns played by one player during one round.
+     *
+     * The view does not own its data and is invalidated when the history is destroyed or reassigned.
+     */
+    class RoundView
+    {
+    public:
+        RoundView(const CellIndex *cells, const CellValue *values, const Rating *ratings, int size)
+            : mp_cells{cells}, mp_values{values}, mp_ratings{ratings}, m_size{size}
+        {
+        }
+
+        /** @brief Number of turns in the view. */
+        [[nodiscard]] int size() const { return m_size; }
+        /** @brief Index of the cell opened at turn `iTurn`. */
+        [[nodiscard]] int getCell(int iTurn) const { return mp_cells[iTurn]; }
+        /** @brief Value of the cell opened at turn `iTurn`. */
+        [[nodiscard]] int getValue(int iTurn) const { return mp_values[iTurn]; }
+        /** @brief Rating given at turn `iTurn`. */
+        [[nodiscard]] int getRating(int iTurn) const { return mp_ratings[iTurn]; }
+
+    private:
+        const CellIndex *mp_cells;
+        const CellValue *mp_values;
+        const Rating *mp_ratings;
+        int m_size;
+    };
+
+    /**
+     * @brief Allocate a zero-filled history for the given game dimensions.
+     *
+     * @param numberOfPlayers Number of players in the game.
+     * @param numberOfRounds Number of rounds in the game.
+     * @param numberOfTurns Number of turns per round.
+     */
+    GameHistory(int numberOfPlayers, int numberOfRounds, int numberOfTurns);
+
+    GameHistory(const GameHistory &other);
+    GameHistory(GameHistory &&other) noexcept = default;
+    GameHistory &operator=(const GameHistory &other);
+    GameHistory &operator=(GameHistory &&other) noexcept = default;
+
+    /**
+     * @brief Record the cell opened by a player.
+     *
+     * @param iPlayer The identifier of the player.
+     * @param iRound The round of the opening.
+     * @param iTurn The turn of the opening.
+     * @param iCell The index of the opened cell.
+     * @param value The value of the opened cell. Must fit in `CellValue`.
+     */
+    void recordOpening(int iPlayer, int iRound, int iTurn, int iCell, int value)
+    {
+        const std::size_t iEntry{offset(iPlayer, iRound, iTurn)};
+        mp_cells[iEntry] = static_cast<CellIndex>(iCell);
+        mp_values[iEntry] = static_cast<CellValue>(value);
+    }
+
+    /**
+     * @brief Record the rating given by a player to the cell opened at the same turn.
+     *
+     * @param iPlayer The identifier of the player.
+     * @param iRound The round of the rating.
+     * @param iTurn The turn of the rating.
+     * @param rating The number of stars given. Must fit in `Rating`.
+     */
+    void recordRating(int iPlayer, int iRound, int iTurn, int rating)
+    {
+        mp_ratings[offset(iPlayer, iRound, iTurn)] = static_cast<Rating>(rating);
+    }
+
+    [[nodiscard]] int getCell(int iPlayer, int iRound, int iTurn) const
+    {
+        return iRound < m_numberOfPrefixRounds ? mp_prefix->getCell(iPlayer, iRound, iTurn)
+                                               : mp_cells[offset(iPlayer, iRound, iTurn)];
+    }
+
+    [[nodiscard]] int getValue(int iPlayer, int iRound, int iTurn) const
+    {
+        return iRound < m_numberOfPrefixRounds ? mp_prefix->getValue(iPlayer, iRound, iTurn)
+                                               : mp_values[offset(iPlayer, iRound, iTurn)];
+    }
+
+    [[nodiscard]] int getRating(int iPlayer, int iRound, int iTurn) const
+    {
+        return iRound < m_numberOfPrefixRounds ? mp_prefix->getRating(iPlayer, iRound, iTurn)
+                                               : mp_ratings[offset(iPlayer, iRound, iTurn)];
+    }
+
+    /**
+     * @brief Reset every entry to zero without reallocating, and stop sharing the prefix if any.
+     */
+    void clear();
+
+    /**
+     * @brief Read the first rounds from another history instead of storing them.
+     *
+     * The entries of the following rounds are left as they are, and must be recorded before being read.
+     *
+     * @param prefix The history holding the first rounds, of the same dimensions. Its first rounds must not
+     *        be modified while they are shared.
+     * @param numberOfRounds The number of rounds read from `prefix`.
+     */
+    void sharePrefix(std::shared_ptr<const GameHistory> prefix, int numberOfRounds);
+
+    /**
+     * @brief Get a view of the first `numberOfTurns` turns played by a player during a round.
+     *
+     * @param iPlayer The identifier of the player.
+     * @param iRound The round.
+     * @param numberOfTurns The number of turns covered by the view.
+     * @return The view of the round.
+     */
+    [[nodiscard]] RoundView getRound(int iPlayer, int iRound, int numberOfTurns) const
+    {
+        if (iRound < m_numberOfPrefixRounds)
+        {
+            return mp_prefix->getRound(iPlayer, iRound, numberOfTurns);
+        }
+        const std::size_t iEntry{offset(iPlayer, iRound, 0)};
+        return {mp_cells + iEntry, mp_values + iEntry, mp_ratings + iEntry, numberOfTurns};
+    }
+
+    /**
+     * @brief Get a view of all the turns played by a player during a round.
+     *
+     * @param iPlayer The identifier of the player.
+     * @param iRound The round.
+     * @return The view of the round.
+     */
+    [[nodiscard]] RoundView getRound(int iPlayer, int iRound) const
+    {
+        return getRound(iPlayer, iRound, m_numberOfTurns);
+    }
+
+    [[nodiscard]] int getNumberOfPlayers() const { return m_numberOfPlayers; }
+
+    [[nodiscard]] int getNumberOfRounds() const { return m_numberOfRounds; }
+
+    [[nodiscard]] int getNumberOfTurns() const { return m_numberOfTurns; }
+
+private:
+    struct AlignedDeleter
+    {
+        void operator()(std::byte *buffer) const;
+    };
+
+    /**
+     * @brief Compute the position of an entry in each plane.
+     */
+    [[nodiscard]] std::size_t offset(int iPlayer, int iRound, int iTurn) const
+    {
+        return (static_cast<std::size_t>(iPlayer) * m_numberOfRounds + iRound) * m_numberOfTurns + iTurn;
+    }
+
+    /**
+     * @brief Allocate the buffer and set the plane pointers. The buffer is zero-filled.
+     */
+    void allocate();
+
+    int m_numberOfPlayers;
+    int m_numberOfRounds;
+    int m_numberOfTurns;
+    std::size_t m_numberOfEntries;
+    std::size_t m_bufferSize;
+    std::unique_ptr<std::byte[], AlignedDeleter> m_buffer;
+    CellIndex *mp_cells;
+    CellValue *mp_values;
+    Rating *mp_ratings;
+    // Shared history of the first rounds, see `sharePrefix`
+    std::shared_ptr<const GameHistory> mp_prefix;
+    int m_numberOfPrefixRounds;
+};
+
+#endif
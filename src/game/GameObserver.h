@@ -0,0 +1,62 @@
+#ifndef GAME_OBSERVER_H
+#define GAME_OBSERVER_H
+
+class Game;
+
+/**
+ * @brief Receives the events of the games it is attached to, see `Game::addObserver`.
+ *
+ * The events are sent while the game is played, so that an observer can update its records while the
+ * data of the move is still in cache, instead of scanning the history of the game once it is over. The
+ * default implementations do nothing, so that an observer only overrides the events it needs.
+ *
+ * When the players of a game play a round concurrently, the events of the cells of different players may be
+ * sent concurrently from their threads, while the change of round is sent once, by the last player.
+ */
+class GameObserver
+{
+public:
+    virtual ~GameObserver() = default;
+
+    /**
+     * @brief Called when a player has opened a cell.
+     *
+     * @param game The game.
+     * @param iPlayer The identifier of the player.
+     * @param iCell The index of the cell.
+     * @param value The value of the cell.
+     */
+    virtual void onCellOpened(const Game & /* game */, int /* iPlayer */, int /* iCell */, int /* value */) {}
+
+    /**
+     * @brief Called when a player has rated the cell it opened, before the round changes if it was the last
+     * rating of the round.
+     *
+     * @param game The game.
+     * @param iPlayer The identifier of the player.
+     * @param iCell The index of the cell.
+     * @param value The value of the cell.
+     * @param rating The number of stars given to the cell.
+     */
+    virtual void onCellRated(const Game & /* game */, int /* iPlayer */, int /* iCell */, int /* value */,
+                             int /* rating */)
+    {
+    }
+
+    /**
+     * @brief Called when a round is over, once the colors and the scores have been updated.
+     *
+     * @param game The game, whose current round is already the next one.
+     * @param iRound The index of the round that is over.
+     */
+    virtual void onRoundChanged(const Game & /* game */, int /* iRound */) {}
+
+    /**
+     * @brief Called when the game has been reset, possibly on another map, or restored from a snapshot.
+     *
+     * @param game The game, ready to be played from its current round.
+     */
+    virtual void onGameReset(const Game & /* game */) {}
+};
+
+#endif
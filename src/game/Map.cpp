@@ -1,14 +1,75 @@
-#include <algorithm> // std::copy, std::shuffle
+#include <algorithm> // std::copy, std::shuffle, std::stable_sort
+#include <cstdint>   // std::uint_fast32_t
+#include <map>       // std::map
+#include <memory>    // std::make_shared, std::shared_ptr
+#include <mutex>     // std::lock_guard, std::mutex
+#include <numeric>   // std::iota
+#include <random>    // std::mt19937
 #include <stdexcept> // std::invalid_argument
 #include <vector>
 
 #include "game/Map.h"
 #include "random/myRandom.h"
 
+namespace
+{
+    constexpr int numberOfCellsPerBlock{225};
+    constexpr int tierSizesPerBlock[Map::numberOfTiers]{1, 4, 4};
+} // namespace
+
 Map::Map(int numberOfCells, bool random)
     : m_numberOfCells{numberOfCells},
       m_values{generateValues(numberOfCells, random)}
 {
+    computeStatistics();
+}
+
+Map::Map(int numberOfCells, std::uint_fast32_t seed)
+    : m_numberOfCells{numberOfCells},
+      m_values{generateValues(numberOfCells, seed)}
+{
+    computeStatistics();
+}
+
+std::shared_ptr<const Map> Map::getShared(int numberOfCells)
+{
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<const Map>> maps;
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const Map> &map{maps[numberOfCells]};
+    if (!map)
+    {
+        map = std::make_shared<const Map>(numberOfCells, false);
+    }
+    return map;
+}
+
+void Map::computeStatistics()
+{
+    m_cellsByValue.resize(m_numberOfCells);
+    std::iota(m_cellsByValue.begin(), m_cellsByValue.end(), 0);
+    std::stable_sort(m_cellsByValue.begin(), m_cellsByValue.end(),
+                     [this](int iCell1, int iCell2)
+                     { return m_values[iCell1] > m_values[iCell2]; });
+
+    m_ranks.resize(m_numberOfCells);
+    m_sumOfBestValues.assign(m_numberOfCells + 1, 0);
+    for (int rank{0}; rank < m_numberOfCells; ++rank)
+    {
+        m_ranks[m_cellsByValue[rank]] = rank;
+        m_sumOfBestValues[rank + 1] = m_sumOfBestValues[rank] + m_values[m_cellsByValue[rank]];
+    }
+
+    // The tiers are consecutive ranges of ranks, scaled with the number of repetitions of the base distribution
+    m_cellsOfTiers.resize(numberOfTiers);
+    int rank{0};
+    for (int iTier{0}; iTier < numberOfTiers; ++iTier)
+    {
+        const int tierSize{tierSizesPerBlock[iTier] * m_numberOfCells / numberOfCellsPerBlock};
+        m_cellsOfTiers[iTier].assign(m_cellsByValue.begin() + rank, m_cellsByValue.begin() + rank + tierSize);
+        rank += tierSize;
+    }
 }
 
 bool Map::isValidIndex(int index) const
@@ -31,6 +92,56 @@ const std::vector<int> &Map::getValues() const
     return m_values;
 }
 
+int Map::getRank(int index) const
+{
+    return m_ranks[index];
+}
+
+const std::vector<int> &Map::getCellsByValue() const
+{
+    return m_cellsByValue;
+}
+
+int Map::getMaxValue() const
+{
+    return m_values[m_cellsByValue[0]];
+}
+
+int Map::getSumOfValues() const
+{
+    return m_sumOfBestValues[m_numberOfCells];
+}
+
+int Map::getSumOfBestValues(int numberOfCells) const
+{
+    return m_sumOfBestValues[numberOfCells];
+}
+
+const std::vector<int> &Map::getCellsOfTier(int iTier) const
+{
+    return m_cellsOfTiers[iTier];
+}
+
+int Map::getTier(int index) const
+{
+    const int numberOfBlocks{m_numberOfCells / numberOfCellsPerBlock};
+    int rankLimit{0};
+    for (int iTier{0}; iTier < numberOfTiers; ++iTier)
+    {
+        rankLimit += tierSizesPerBlock[iTier] * numberOfBlocks;
+        if (m_ranks[index] < rankLimit)
+        {
+            return iTier;
+        }
+    }
+    return -1;
+}
+
+int Map::getTierSizePerBlock(int iTier)
+{
+    return tierSizesPerBlock[iTier];
+}
+
 std::vector<int> Map::generateValues(int numberOfCells, bool random)
 {
     const std::vector<int> baseValues{99, 86, 86, 85, 84, 72, 72, 71, 71, 53, 53, 53, 51, 46, 45,
@@ -49,7 +160,7 @@ std::vector<int> Map::generateValues(int numberOfCells, bool random)
                                       1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0,
                                       0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
-    if (numberOfCells % baseValues.size() != 0)
+    if (numberOfCells <= 0 || numberOfCells % baseValues.size() != 0)
     {
         throw std::invalid_argument("The number of cells must be a multiple of 225.");
     }
@@ -68,3 +179,11 @@ std::vector<int> Map::generateValues(int numberOfCells, bool random)
 
     return values;
 }
+
+std::vector<int> Map::generateValues(int numberOfCells, std::uint_fast32_t seed)
+{
+    std::vector<int> values{generateValues(numberOfCells, false)};
+    std::mt19937 engine(seed);
+    std::shuffle(values.begin(), values.end(), engine);
+    return values;
+}
@@ -1,6 +1,8 @@
 #ifndef MAP_H
 #define MAP_H
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 /**
@@ -8,10 +10,22 @@
  *
  * The map is generated from a fixed base distribution of 225 values. Larger maps are built by
  * repeating that distribution and, optionally, shuffling the resulting values.
+ *
+ * A map is immutable once built. The statistics derived from its values (ranks, cells sorted by
+ * value, sums of the best values, tiers of best cells) are computed once at construction, so that
+ * maps can be shared by all the games and threads of a simulation, see `Map::getShared`.
  */
 class Map
 {
 public:
+    /**
+     * @brief Number of tiers of best cells tracked by the map.
+     *
+     * In the base distribution, the tiers are the value-99 cell, the 86/86/85/84 cells and the
+     * 72/72/71/71 cells.
+     */
+    static constexpr int numberOfTiers{3};
+
     /**
      * @brief Build a map with the given number of cells.
      *
@@ -20,6 +34,27 @@ public:
      */
     Map(int numberOfCells, bool random);
 
+    /**
+     * @brief Build a map whose cell values are shuffled by a generator of the given seed.
+     *
+     * The same seed always gives the same map, whatever the state of the random engine of the thread, so
+     * that the maps of a simulation can be drawn in advance and reproduced, see `MapPool`.
+     *
+     * @param numberOfCells Number of cells in the map. Must be a multiple of 225.
+     * @param seed The seed of the shuffle.
+     */
+    Map(int numberOfCells, std::uint_fast32_t seed);
+
+    /**
+     * @brief Get the non-shuffled map with the given number of cells.
+     *
+     * The map is built on the first call and shared by all later callers, from any thread.
+     *
+     * @param numberOfCells Number of cells in the map. Must be a multiple of 225.
+     * @return A shared pointer to the map.
+     */
+    static std::shared_ptr<const Map> getShared(int numberOfCells);
+
     /**
      * @brief Check whether an index refers to a valid cell.
      *
@@ -50,9 +85,82 @@ public:
      */
     [[nodiscard]] const std::vector<int> &getValues() const;
 
+    /**
+     * @brief Get the rank of a cell, 0 being the cell with the highest value.
+     *
+     * Cells of equal value are ranked by increasing index.
+     *
+     * @param index The cell index.
+     * @return The rank of the cell.
+     */
+    [[nodiscard]] int getRank(int index) const;
+
+    /**
+     * @brief Get the indices of all cells sorted by decreasing value.
+     *
+     * @return A reference to the vector of cell indices, the i-th entry being the cell of rank i.
+     */
+    [[nodiscard]] const std::vector<int> &getCellsByValue() const;
+
+    /**
+     * @brief Get the highest value of the map.
+     *
+     * @return The value of the cell of rank 0.
+     */
+    [[nodiscard]] int getMaxValue() const;
+
+    /**
+     * @brief Get the sum of the values of all cells.
+     *
+     * @return The sum of the values.
+     */
+    [[nodiscard]] int getSumOfValues() const;
+
+    /**
+     * @brief Get the sum of the values of the best cells.
+     *
+     * @param numberOfCells The number of best cells to sum. Must be in [0, `getNumberOfCells()`].
+     * @return The sum of the values of the cells of rank 0 to `numberOfCells - 1`.
+     */
+    [[nodiscard]] int getSumOfBestValues(int numberOfCells) const;
+
+    /**
+     * @brief Get the cells of a tier of best cells.
+     *
+     * @param iTier The tier, in [0, `numberOfTiers`).
+     * @return A reference to the indices of the cells of the tier, sorted by rank.
+     */
+    [[nodiscard]] const std::vector<int> &getCellsOfTier(int iTier) const;
+
+    /**
+     * @brief Get the tier of a cell.
+     *
+     * @param index The cell index.
+     * @return The tier of the cell, or -1 if the cell does not belong to any tier.
+     */
+    [[nodiscard]] int getTier(int index) const;
+
+    /**
+     * @brief Get the number of cells of a tier in each block of 225 cells.
+     *
+     * @param iTier The tier, in [0, `numberOfTiers`).
+     * @return The number of cells of the tier per 225 cells (1, 4 and 4 for the three tiers).
+     */
+    [[nodiscard]] static int getTierSizePerBlock(int iTier);
+
 private:
     const int m_numberOfCells;
     const std::vector<int> m_values;
+    // Derived statistics
+    std::vector<int> m_cellsByValue;
+    std::vector<int> m_ranks;
+    std::vector<int> m_sumOfBestValues;
+    std::vector<std::vector<int>> m_cellsOfTiers;
+
+    /**
+     * @brief Compute the statistics derived from the values.
+     */
+    void computeStatistics();
 
     /**
      * @brief Generate the vector of cell values from the base distribution.
@@ -62,6 +170,16 @@ private:
      * @return The generated vector of cell values.
      */
     static std::vector<int> generateValues(int numberOfCells, bool random);
+
+    /**
+     * @brief Generate the vector of cell values from the base distribution, shuffled by a generator of the
+     * given seed.
+     *
+     * @param numberOfCells Number of cells in the map. Must be a multiple of 225.
+     * @param seed The seed of the shuffle.
+     * @return The generated vector of cell values.
+     */
+    static std::vector<int> generateValues(int numberOfCells, std::uint_fast32_t seed);
 };
 
 #endif
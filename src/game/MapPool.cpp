@@ -0,0 +1,39 @@
+#include <cstdint>   // std::uint_fast32_t
+#include <memory>    // std::make_shared, std::shared_ptr
+#include <random>    // std::mt19937
+#include <stdexcept> // std::invalid_argument
+#include <vector>
+
+#include "game/MapPool.h"
+
+MapPool::MapPool(int numberOfCells, int numberOfMaps, std::uint_fast32_t seed)
+    : m_numberOfCells{numberOfCells},
+      m_maps{}
+{
+    if (numberOfMaps <= 0)
+    {
+        throw std::invalid_argument("The number of maps of the pool must be positive.");
+    }
+
+    std::mt19937 seeds(seed);
+    m_maps.reserve(numberOfMaps);
+    for (int iMap{0}; iMap < numberOfMaps; ++iMap)
+    {
+        m_maps.push_back(std::make_shared<const Map>(numberOfCells, static_cast<std::uint_fast32_t>(seeds())));
+    }
+}
+
+int MapPool::getNumberOfCells() const
+{
+    return m_numberOfCells;
+}
+
+int MapPool::getNumberOfMaps() const
+{
+    return static_cast<int>(m_maps.size());
+}
+
+const std::shared_ptr<const Map> &MapPool::getMap(int iGame) const
+{
+    return m_maps[iGame % m_maps.size()];
+}
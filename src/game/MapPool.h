@@ -0,0 +1,48 @@
+#ifndef MAP_POOL_H
+#define MAP_POOL_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "game/Map.h"
+
+/**
+ * @brief A fixed set of shuffled maps, from which each game of a simulation draws its own map.
+ *
+ * The maps are shuffled once at construction, each with its own seed derived from the seed of the pool, so
+ * that playing a game on a random map costs no more than playing it on the fixed map: the game only
+ * switches to a pointer to an already built map, whose ranks and tiers of best cells are already known. The
+ * map of a game only depends on the index of the game, so that a simulation is reproducible whatever the
+ * number of threads. A pool is immutable once built, and can be shared by all the games and threads.
+ */
+class MapPool
+{
+public:
+    /**
+     * @brief Build and shuffle the maps of the pool.
+     *
+     * @param numberOfCells Number of cells of the maps. Must be a multiple of 225.
+     * @param numberOfMaps Number of maps of the pool. Must be positive.
+     * @param seed The seed from which the seeds of the maps are drawn.
+     */
+    MapPool(int numberOfCells, int numberOfMaps, std::uint_fast32_t seed);
+
+    [[nodiscard]] int getNumberOfCells() const;
+
+    [[nodiscard]] int getNumberOfMaps() const;
+
+    /**
+     * @brief Get the map of a game.
+     *
+     * @param iGame The index of the game in the simulation. The games cycle through the maps of the pool.
+     * @return A reference to the shared pointer to the map, valid as long as the pool.
+     */
+    [[nodiscard]] const std::shared_ptr<const Map> &getMap(int iGame) const;
+
+private:
+    const int m_numberOfCells;
+    std::vector<std::shared_ptr<const Map>> m_maps;
+};
+
+#endif
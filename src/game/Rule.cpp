@@ -1,58 +1,37 @@
-#include <numeric>   // std::accumulate, std::inner_product
-#include <stdexcept> // std::invalid_argument
-#include <string>
-#include <vector>
-
+#include "game/GameHistory.h"
 #include "game/Rule.h"
 
 Rule::Rule(RuleNumber ruleNumber)
     : m_ruleNumber{ruleNumber},
       m_minRating{0},
       m_maxRating{5},
-      m_maxRatingPerRound{maxRatingPerRoundFor(ruleNumber)}
+      m_maxRatingPerRound{visitRule(ruleNumber, [](auto rule) { return rule.maxRatingPerRound; })},
+      mp_scoreOfTurn{visitRule(ruleNumber, [](auto rule) { return &decltype(rule)::scoreOfTurn; })},
+      mp_scoreOfRemainingRatings{
+          visitRule(ruleNumber, [](auto rule) { return &decltype(rule)::scoreOfRemainingRatings; })}
 {
 }
 
-int Rule::maxRatingPerRoundFor(RuleNumber ruleNumber)
+int Rule::calculateScore(const GameHistory::RoundView &round) const
 {
-    switch (ruleNumber)
+    int score{0};
+    int numberOfRatingsRemaining{m_maxRatingPerRound};
+    for (int iTurn{0}; iTurn < round.size(); ++iTurn)
     {
-    case RuleNumber::Rule1:
-    case RuleNumber::Rule2:
-        return 15;
-    case RuleNumber::Rule3:
-    case RuleNumber::Rule4:
-        return 8;
+        score += scoreOfTurn(round.getValue(iTurn), round.getRating(iTurn));
+        numberOfRatingsRemaining -= round.getRating(iTurn);
     }
-    throw std::invalid_argument{"Invalid rule number"};
+    return score + scoreOfRemainingRatings(numberOfRatingsRemaining);
 }
 
-int Rule::calculateScore(const std::vector<int> &values, const std::vector<int> &stars) const
+bool Rule::isValidRating(int rating) const
 {
-    switch (m_ruleNumber)
-    {
-    case RuleNumber::Rule1:
-        return 0;
-
-    case RuleNumber::Rule2:
-        return std::accumulate(values.begin(), values.end(), 0);
-
-    case RuleNumber::Rule3:
-        return std::inner_product(values.begin(), values.end(), stars.begin(), 0);
-
-    case RuleNumber::Rule4:
-    {
-        const int used = std::accumulate(stars.begin(), stars.end(), 0);
-        const int leftover = m_maxRatingPerRound - used;
-        return std::inner_product(values.begin(), values.end(), stars.begin(), 0) + leftover * 50;
-    }
-    }
-    throw std::invalid_argument{"Invalid rule number"};
+    return m_minRating <= rating && rating <= m_maxRating;
 }
 
-bool Rule::isValidRating(int rating) const
+RuleNumber Rule::getRuleNumber() const
 {
-    return m_minRating <= rating && rating <= m_maxRating;
+    return m_ruleNumber;
 }
 
 int Rule::getMinRating() const
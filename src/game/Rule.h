@@ -1,7 +1,9 @@
 #ifndef GAME_RULE_H
 #define GAME_RULE_H
 
-#include <vector>
+#include <stdexcept> // std::invalid_argument
+
+#include "game/GameHistory.h"
 
 /**
  * @brief Identifier for the scoring rule used by a game.
@@ -21,8 +23,87 @@ enum class RuleNumber
     Rule4,
 };
 
+/**
+ * @brief Scoring policies, one type per rule.
+ *
+ * The score of a round is the sum of `scoreOfTurn` over the turns of the round, plus
+ * `scoreOfRemainingRatings` of the stars left unspent at the end of the round. The score can thus be
+ * accumulated turn after turn as the cells are rated, and committed at the change of round. A new rule
+ * only needs a new policy and a case in `visitRule`.
+ */
+struct Rule1
+{
+    static constexpr RuleNumber ruleNumber{RuleNumber::Rule1};
+    static constexpr int maxRatingPerRound{15};
+
+    static constexpr int scoreOfTurn(int /* value */, int /* rating */) { return 0; }
+
+    static constexpr int scoreOfRemainingRatings(int /* numberOfRatingsRemaining */) { return 0; }
+};
+
+struct Rule2
+{
+    static constexpr RuleNumber ruleNumber{RuleNumber::Rule2};
+    static constexpr int maxRatingPerRound{15};
+
+    static constexpr int scoreOfTurn(int value, int /* rating */) { return value; }
+
+    static constexpr int scoreOfRemainingRatings(int /* numberOfRatingsRemaining */) { return 0; }
+};
+
+struct Rule3
+{
+    static constexpr RuleNumber ruleNumber{RuleNumber::Rule3};
+    static constexpr int maxRatingPerRound{8};
+
+    static constexpr int scoreOfTurn(int value, int rating) { return value * rating; }
+
+    static constexpr int scoreOfRemainingRatings(int /* numberOfRatingsRemaining */) { return 0; }
+};
+
+struct Rule4
+{
+    static constexpr RuleNumber ruleNumber{RuleNumber::Rule4};
+    static constexpr int maxRatingPerRound{8};
+
+    static constexpr int scoreOfTurn(int value, int rating) { return value * rating; }
+
+    static constexpr int scoreOfRemainingRatings(int numberOfRatingsRemaining) { return 50 * numberOfRatingsRemaining; }
+};
+
+/**
+ * @brief Call `function` with the scoring policy of a rule.
+ *
+ * This is the only place where the rule identifier is switched on; callers dispatch once, e.g. per game,
+ * and run their loops with the policy known at compile time. The function must therefore be generic,
+ * typically a lambda taking an `auto` parameter, and return the same type for all the policies.
+ *
+ * @param ruleNumber The rule identifier.
+ * @return The value returned by `function`.
+ * @throw std::invalid_argument If the rule identifier is invalid.
+ */
+template <typename Function>
+decltype(auto) visitRule(RuleNumber ruleNumber, Function &&function)
+{
+    switch (ruleNumber)
+    {
+    case RuleNumber::Rule1:
+        return function(Rule1{});
+    case RuleNumber::Rule2:
+        return function(Rule2{});
+    case RuleNumber::Rule3:
+        return function(Rule3{});
+    case RuleNumber::Rule4:
+        return function(Rule4{});
+    }
+    throw std::invalid_argument{"Invalid rule number"};
+}
+
 /**
  * @brief Encapsulates the scoring rule of a game.
+ *
+ * The rule is chosen at run time but its scoring functions are those of the matching policy, bound
+ * once at construction, so that scoring a turn involves no switch on the rule.
  */
 class Rule
 {
@@ -37,11 +118,30 @@ public:
     /**
      * @brief Compute the score contributed by a single round.
      *
-     * @param values The values of the cells opened during the round, in order of opening.
-     * @param stars The number of stars given to each opened cell, in the same order.
+     * @param round The cells opened and rated by the player during the round.
      * @return The score for the round according to the active rule.
      */
-    [[nodiscard]] int calculateScore(const std::vector<int> &values, const std::vector<int> &stars) const;
+    [[nodiscard]] int calculateScore(const GameHistory::RoundView &round) const;
+
+    /**
+     * @brief Compute the score contributed by a single turn.
+     *
+     * @param value The value of the cell opened during the turn.
+     * @param rating The rating given to the cell.
+     */
+    [[nodiscard]] int scoreOfTurn(int value, int rating) const { return mp_scoreOfTurn(value, rating); }
+
+    /**
+     * @brief Compute the score contributed by the stars left unspent at the end of a round.
+     *
+     * @param numberOfRatingsRemaining The number of stars the player did not spend during the round.
+     */
+    [[nodiscard]] int scoreOfRemainingRatings(int numberOfRatingsRemaining) const
+    {
+        return mp_scoreOfRemainingRatings(numberOfRatingsRemaining);
+    }
+
+    [[nodiscard]] RuleNumber getRuleNumber() const;
 
     /**
      * @brief Check if a rating is within the allowed range for this rule.
@@ -73,18 +173,12 @@ public:
     [[nodiscard]] int getMaxRatingPerRound() const;
 
 private:
-    /**
-     * @brief Return the maximum rating per round associated with a rule identifier.
-     *
-     * @param ruleNumber The rule identifier.
-     * @return The maximum rating budget per round.
-     */
-    static int maxRatingPerRoundFor(RuleNumber ruleNumber);
-
     const RuleNumber m_ruleNumber;
     const int m_minRating;
     const int m_maxRating;
     const int m_maxRatingPerRound;
+    int (*const mp_scoreOfTurn)(int, int);
+    int (*const mp_scoreOfRemainingRatings)(int);
 };
 
 #endif
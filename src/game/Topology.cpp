@@ -0,0 +1,106 @@
+#include <algorithm> // std::sort, std::unique
+#include <cmath>     // std::abs, std::lround, std::sqrt
+#include <stdexcept> // std::invalid_argument
+#include <utility>   // std::pair
+#include <vector>
+
+#include "game/Topology.h"
+
+Topology::Topology(int width, int height, Neighbourhood neighbourhood, int radius, bool periodic)
+    : m_width{width},
+      m_height{height},
+      m_periodic{periodic},
+      m_neighbourOffsets{},
+      m_neighbours{}
+{
+    if (width <= 0 || height <= 0)
+    {
+        throw std::invalid_argument("The width and the height of the grid must be positive.");
+    }
+    if (radius <= 0)
+    {
+        throw std::invalid_argument("The radius of the neighbourhoods must be positive.");
+    }
+
+    m_neighbourOffsets.assign(width * height + 1, 0);
+
+    // The displacements of the stencil are the same for all the cells
+    std::vector<std::pair<int, int>> stencil;
+    for (int dy{-radius}; dy <= radius; ++dy)
+    {
+        for (int dx{-radius}; dx <= radius; ++dx)
+        {
+            const bool isInside{neighbourhood == Neighbourhood::Moore || std::abs(dx) + std::abs(dy) <= radius};
+            if (isInside && (dx != 0 || dy != 0))
+            {
+                stencil.emplace_back(dx, dy);
+            }
+        }
+    }
+
+    std::vector<int> neighbours;
+    for (int iCell{0}; iCell < width * height; ++iCell)
+    {
+        neighbours.clear();
+        for (const auto &[dx, dy] : stencil)
+        {
+            const int iNeighbour{getShiftedCell(iCell, dx, dy)};
+            if (iNeighbour >= 0 && iNeighbour != iCell)
+            {
+                neighbours.push_back(iNeighbour);
+            }
+        }
+        // On small periodic grids, several displacements may lead to the same cell
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+        m_neighbours.insert(m_neighbours.end(), neighbours.begin(), neighbours.end());
+        m_neighbourOffsets[iCell + 1] = static_cast<int>(m_neighbours.size());
+    }
+}
+
+Topology::Topology(int numberOfCells)
+    : Topology(computeSide(numberOfCells), computeSide(numberOfCells), Neighbourhood::Moore, 1, false)
+{
+}
+
+int Topology::getNumberOfCells() const
+{
+    return m_width * m_height;
+}
+
+int Topology::getWidth() const
+{
+    return m_width;
+}
+
+int Topology::getHeight() const
+{
+    return m_height;
+}
+
+int Topology::getShiftedCell(int iCell, int dx, int dy) const
+{
+    int x{getX(iCell) + dx};
+    int y{getY(iCell) + dy};
+    if (m_periodic)
+    {
+        x = ((x % m_width) + m_width) % m_width;
+        y = ((y % m_height) + m_height) % m_height;
+    }
+    else if (x < 0 || x >= m_width || y < 0 || y >= m_height)
+    {
+        return -1;
+    }
+    return getIndex(x, y);
+}
+
+int Topology::computeSide(int numberOfCells)
+{
+    const int side{static_cast<int>(std::lround(std::sqrt(static_cast<double>(numberOfCells))))};
+    if (numberOfCells <= 0 || side * side != numberOfCells)
+    {
+        throw std::invalid_argument("The number of cells of a square grid must be a perfect square.");
+    }
+    return side;
+}
@@ -0,0 +1,116 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <vector>
+
+/**
+ * @brief The shape of the neighbourhood of a cell in a `Topology`.
+ */
+enum class Neighbourhood
+{
+    VonNeumann, // The cells at a Manhattan distance of at most the radius
+    Moore,      // The cells at a Chebyshev distance of at most the radius
+};
+
+/**
+ * @brief An optional 2D arrangement of the cells of a map, with the neighbourhood of every cell.
+ *
+ * The cells are laid out row by row on a grid of `width x height` cells, the cell at column `x` and row
+ * `y` having the index `y * width + x`, so that the 225 cells of the experiments form a 15 x 15 grid. The
+ * neighbours of all the cells are computed once at construction and stored contiguously, so that the
+ * neighbourhood of a cell is scanned in time proportional to its size. A topology is immutable once built,
+ * and can be shared by all the games and threads of a simulation.
+ */
+class Topology
+{
+public:
+    /**
+     * @brief Read-only view of the neighbours of a cell, sorted by increasing index.
+     */
+    class Neighbours
+    {
+    public:
+        Neighbours(const int *begin, const int *end) : mp_begin{begin}, mp_end{end} {}
+
+        [[nodiscard]] const int *begin() const { return mp_begin; }
+        [[nodiscard]] const int *end() const { return mp_end; }
+        /** @brief Number of neighbours. */
+        [[nodiscard]] int size() const { return static_cast<int>(mp_end - mp_begin); }
+        /** @brief Index of the `i`-th neighbour. */
+        [[nodiscard]] int operator[](int i) const { return mp_begin[i]; }
+
+    private:
+        const int *mp_begin;
+        const int *mp_end;
+    };
+
+    /**
+     * @brief Build the grid and the neighbourhoods of its cells.
+     *
+     * @param width Number of columns of the grid.
+     * @param height Number of rows of the grid.
+     * @param neighbourhood The shape of the neighbourhoods.
+     * @param radius The radius of the neighbourhoods. Must be positive.
+     * @param periodic If `true`, the edges of the grid wrap around; otherwise the cells near the edges have
+     *        fewer neighbours.
+     */
+    Topology(int width, int height, Neighbourhood neighbourhood, int radius, bool periodic);
+
+    /**
+     * @brief Build a square grid whose cells have their 8 nearest neighbours, without wrapping around.
+     *
+     * @param numberOfCells Number of cells of the grid. Must be a perfect square.
+     */
+    explicit Topology(int numberOfCells);
+
+    [[nodiscard]] int getNumberOfCells() const;
+
+    [[nodiscard]] int getWidth() const;
+
+    [[nodiscard]] int getHeight() const;
+
+    /** @brief Column of a cell. */
+    [[nodiscard]] int getX(int iCell) const { return iCell % m_width; }
+
+    /** @brief Row of a cell. */
+    [[nodiscard]] int getY(int iCell) const { return iCell / m_width; }
+
+    /** @brief Index of the cell at a column and a row of the grid. */
+    [[nodiscard]] int getIndex(int x, int y) const { return y * m_width + x; }
+
+    /**
+     * @brief Get the neighbours of a cell, not including the cell itself.
+     *
+     * @param iCell The index of the cell.
+     * @return A view of the neighbours, valid as long as the topology.
+     */
+    [[nodiscard]] Neighbours getNeighbours(int iCell) const
+    {
+        return {m_neighbours.data() + m_neighbourOffsets[iCell], m_neighbours.data() + m_neighbourOffsets[iCell + 1]};
+    }
+
+    /**
+     * @brief Get the cell next to a cell along a direction of the grid, wrapping around if the grid is periodic.
+     *
+     * @param iCell The index of the cell.
+     * @param dx The displacement along the rows.
+     * @param dy The displacement along the columns.
+     * @return The index of the cell, or -1 if it is outside of a non-periodic grid.
+     */
+    [[nodiscard]] int getShiftedCell(int iCell, int dx, int dy) const;
+
+private:
+    const int m_width;
+    const int m_height;
+    const bool m_periodic;
+    // Neighbours of the cell `iCell` are `m_neighbours[m_neighbourOffsets[iCell] : m_neighbourOffsets[iCell + 1]]`
+    std::vector<int> m_neighbourOffsets;
+    std::vector<int> m_neighbours;
+
+    /**
+     * @brief Compute the side of a square grid of the given number of cells.
+     */
+    static int computeSide(int numberOfCells);
+};
+
+#endif
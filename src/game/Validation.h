@@ -0,0 +1,25 @@
+#ifndef GAME_VALIDATION_H
+#define GAME_VALIDATION_H
+
+/**
+ * @brief Validation policy that checks every move and throws a `GameException` on invalid ones.
+ *
+ * This is the default of `Game::openCell` and `Game::rateCell`, suited to untrusted callers such as
+ * interactive or replayed experimental games.
+ */
+struct CheckedValidation
+{
+    static constexpr bool enabled{true};
+};
+
+/**
+ * @brief Validation policy for trusted callers: the moves are assumed to be valid and are not checked.
+ *
+ * An invalid move leaves the game in an undefined state.
+ */
+struct UncheckedValidation
+{
+    static constexpr bool enabled{false};
+};
+
+#endif
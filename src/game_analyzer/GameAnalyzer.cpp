@@ -1,15 +1,23 @@
-#include <algorithm> // std::transform
+#include <algorithm> // std::fill, std::find, std::lower_bound, std::sort, std::transform, std::unique
+#include <array>     // std::array
 #include <cmath>     // std::sqrt, std::nan
 #include <fstream>   // std::ofstream
+#include <mutex>     // std::lock_guard, std::mutex
 #include <numeric>   // std::accumulate, std::iota
 #include <stdexcept> // std::runtime_error
 #include <string>
+#include <utility>   // std::swap
 #include <vector>
 
 #include "agent/Agent.h"
+#include "agent/BestCells.h"
 #include "agent/Cell.h"
+#include "game/Dimensions.h"
 #include "game/Game.h"
+#include "game/GameHistory.h"
+#include "game/Map.h"
 #include "game_analyzer/GameAnalyzer.h"
+#include "game_batch/GameBatch.h"
 
 GameAnalyzer::GameAnalyzer(int numberOfGames, std::vector<int> iAgents)
     : m_numberOfGames{numberOfGames},
@@ -26,6 +34,11 @@ GameAnalyzer::GameAnalyzer(int numberOfGames, int numberOfPlayers)
 }
 
 void GameAnalyzer::initialize(int numberOfRounds, int numberOfTurns, int numberOfCells)
+{
+    initialize(numberOfRounds, numberOfTurns, *Map::getShared(numberOfCells));
+}
+
+void GameAnalyzer::initialize(int numberOfRounds, int numberOfTurns, const Map &map)
 {
     if (m_isInitialized)
     {
@@ -33,30 +46,54 @@ void GameAnalyzer::initialize(int numberOfRounds, int numberOfTurns, int numberO
     }
     m_numberOfRounds = numberOfRounds;
     m_numberOfTurns = numberOfTurns;
-    m_numberOfCells = numberOfCells;
-    initializeBuffers();
+    m_numberOfCells = map.getNumberOfCells();
+    initializeBuffers(map.getMaxValue());
     m_isInitialized = true;
 }
 
 void GameAnalyzer::analyzeGame(int iGame, const Game &game, const std::vector<Agent> &agents)
 {
-    computeDistributions(iGame, game);
+    const DynamicDimensions dimensions(m_numberOfRounds, m_numberOfTurns, game.getNumberOfPlayers(), m_numberOfCells);
+    computeDistributions(iGame, dimensions, game.getHistory(), game.getMap());
 
     int iAgentToAnalyze{0};
     for (auto iAgent : m_iAgents)
     {
-        computeValuesBestCells(iGame, agents[iAgent]);
-        computeValuesBestCellsSinceStart(iGame, agents[iAgent]);
-        computeReplayBestCells(iGame, agents[iAgent]);
-        computeFindBestCells(iGame, agents[iAgent]);
-        computeScore(iGame, game, iAgent, iAgentToAnalyze);
-        computeRank(iGame, game, iAgent, iAgentToAnalyze);
-        computeMNS(iGame, game, iAgent);
+        analyzeAgent(iGame, dimensions, game.getHistory(), game.getMap(), game.getScores(),
+                     agents[iAgent].getBestCells(), iAgent, iAgentToAnalyze);
+        ++iAgentToAnalyze;
+    }
+}
 
+template <typename Dimensions>
+void GameAnalyzer::analyzeGame(int iGame, const BasicGameBatch<Dimensions> &batch, int iGameInBatch)
+{
+    const Dimensions &dimensions{batch.getDimensions()};
+    computeDistributions(iGame, dimensions, batch.getHistory(iGameInBatch), batch.getMap(iGameInBatch));
+
+    int iAgentToAnalyze{0};
+    for (auto iAgent : m_iAgents)
+    {
+        analyzeAgent(iGame, dimensions, batch.getHistory(iGameInBatch), batch.getMap(iGameInBatch),
+                     batch.getScores(iGameInBatch), batch.getBestCells(iGameInBatch, iAgent), iAgent, iAgentToAnalyze);
         ++iAgentToAnalyze;
     }
 }
 
+template <typename Dimensions, typename Scores, typename BestCells>
+void GameAnalyzer::analyzeAgent(int iGame, const Dimensions &dimensions, const GameHistory &history, const Map &map,
+                                const Scores &scores, const BestCells &bestCells, int iAgent, int iAgentToAnalyze)
+{
+    AgentProgress progress(dimensions.numberOfTurns());
+    for (int iRound{0}; iRound < dimensions.numberOfRounds(); ++iRound)
+    {
+        recordBestCells(iGame, iRound, map, bestCells[iRound], bestCells[iRound > 0 ? iRound - 1 : 0], progress);
+    }
+    computeScore(iGame, map, scores, iAgent, iAgentToAnalyze);
+    computeRank(iGame, scores, iAgent, iAgentToAnalyze);
+    computeMNS(iGame, dimensions, history, iAgent);
+}
+
 void GameAnalyzer::saveObservables(std::string pathObservables) const
 {
     saveObservable(pathObservables + "q_", get_q());
@@ -128,10 +165,10 @@ void GameAnalyzer::initializeVariables(const Game &game)
     m_numberOfRounds = game.getNumberOfRounds();
     m_numberOfTurns = game.getNumberOfTurns();
     m_numberOfCells = game.getNumberOfCells();
-    initializeBuffers();
+    initializeBuffers(game.getMap().getMaxValue());
 }
 
-void GameAnalyzer::initializeBuffers()
+void GameAnalyzer::initializeBuffers(int maxValue)
 {
     m_q = std::vector<std::vector<double>>(m_numberOfRounds, std::vector<double>(m_numberOfGames, 0.));
     m_Q = std::vector<std::vector<double>>(m_numberOfRounds, std::vector<double>(m_numberOfGames, 0.));
@@ -146,178 +183,192 @@ void GameAnalyzer::initializeBuffers()
     m_B = std::vector<std::vector<std::vector<double>>>(m_numberOfTurns, std::vector<std::vector<double>>(m_numberOfRounds, std::vector<double>(m_numberOfGames, 0.)));
     m_V = std::vector<std::vector<std::vector<double>>>(m_numberOfTurns, std::vector<std::vector<double>>(m_numberOfRounds, std::vector<double>(m_numberOfGames, 0.)));
     m_VB = std::vector<std::vector<std::vector<double>>>(m_numberOfTurns, std::vector<std::vector<double>>(m_numberOfRounds, std::vector<double>(m_numberOfGames, 0.)));
-    m_find = std::vector<std::vector<std::vector<double>>>(m_numberOfTurns, std::vector<std::vector<double>>(m_numberOfRounds, std::vector<double>(m_numberOfGames, 0.)));
+    m_find = std::vector<std::vector<std::vector<double>>>(Map::numberOfTiers, std::vector<std::vector<double>>(m_numberOfRounds, std::vector<double>(m_numberOfGames, 0.)));
     m_S = std::vector<double>(m_numberOfGames * m_numberOfPlayersToAnalyze, 0.);
     m_S_group = std::vector<double>(m_numberOfGames, 0.);
     m_rank = std::vector<double>(m_numberOfGames * m_numberOfPlayersToAnalyze, 0.);
-    m_MNS_ratings = std::vector<int>(100, 0);
-    m_MNS_counts = std::vector<int>(100, 0);
-    // TODO: change 100 to Vmax1 et calculer Vmax1, VMax2, ... ici
+    m_MNS_ratings = std::vector<int>(maxValue + 1, 0);
+    m_MNS_counts = std::vector<int>(maxValue + 1, 0);
 }
 
-void GameAnalyzer::computeDistributions(int iGame, const Game &game)
+template <typename Dimensions>
+void GameAnalyzer::computeDistributions(int iGame, const Dimensions &dimensions, const GameHistory &history,
+                                        const Map &map)
 {
-    std::vector<std::vector<int>> oMapInst(m_numberOfRounds, std::vector<int>(m_numberOfCells, 0));
-    std::vector<std::vector<int>> rMapInst(m_numberOfRounds, std::vector<int>(m_numberOfCells, 0));
-    std::vector<std::vector<int>> oMapCum(m_numberOfRounds, std::vector<int>(m_numberOfCells, 0));
-    std::vector<std::vector<int>> rMapCum(m_numberOfRounds, std::vector<int>(m_numberOfCells, 0));
+    // The distributions are 0 outside of the cells visited during the game, which are few even on large maps,
+    // so they are only stored for these cells, sorted by index so that the sums are the same as over all cells
+    VisitedCells sinceStart;
+    std::vector<int> &visitedCells{sinceStart.cells};
+    visitedCells.reserve(m_iAgents.size() * dimensions.numberOfRounds() * dimensions.numberOfTurns());
     for (auto iAgent : m_iAgents)
     {
-        for (int iRound{0}; iRound < m_numberOfRounds; ++iRound)
+        for (int iRound{0}; iRound < dimensions.numberOfRounds(); ++iRound)
         {
-            for (int iTurn{0}; iTurn < m_numberOfTurns; ++iTurn)
+            const GameHistory::RoundView round{history.getRound(iAgent, iRound, dimensions.numberOfTurns())};
+            for (int iTurn{0}; iTurn < dimensions.numberOfTurns(); ++iTurn)
             {
-                const int iCell{game.m_iCellOpened[iAgent][iRound][iTurn]};
-                const int rCell{game.m_rCellOpened[iAgent][iRound][iTurn]};
-
-                ++oMapInst[iRound][iCell];
-                rMapInst[iRound][iCell] += rCell;
-
-                for (int iRound2{iRound}; iRound2 < m_numberOfRounds; ++iRound2)
-                {
-                    ++oMapCum[iRound2][iCell];
-                    rMapCum[iRound2][iCell] += rCell;
-                }
+                visitedCells.push_back(round.getCell(iTurn));
             }
         }
     }
-
-    const int Vmax1{99}; // TODO: change that
-    const int Vmax2{86}; // TODO: change that
-    const int Vmax3{86}; // TODO: change that
-
-    for (int iRound{0}; iRound < game.m_numberOfRounds; ++iRound)
+    std::sort(visitedCells.begin(), visitedCells.end());
+    visitedCells.erase(std::unique(visitedCells.begin(), visitedCells.end()), visitedCells.end());
+    const int numberOfVisitedCells{static_cast<int>(visitedCells.size())};
+    sinceStart.values.resize(numberOfVisitedCells);
+    for (int iVisited{0}; iVisited < numberOfVisitedCells; ++iVisited)
     {
-        const std::vector<double> oDistInst{normalize(oMapInst[iRound])};
-        const std::vector<double> rDistInst{normalize(rMapInst[iRound])};
-        const std::vector<double> oDistCum{normalize(oMapCum[iRound])};
-        const std::vector<double> rDistCum{normalize(rMapCum[iRound])};
-
-        m_q[iRound][iGame] = computePerf(oDistInst, game.m_map.getValues(), (Vmax1 + Vmax2 + Vmax3) / 3.);
-        m_Q[iRound][iGame] = computePerf(oDistCum, game.m_map.getValues(), (Vmax1 + Vmax2 + Vmax3) / 3.);
-        m_p[iRound][iGame] = computePerf(rDistInst, game.m_map.getValues(), Vmax1);
-        m_P[iRound][iGame] = computePerf(rDistCum, game.m_map.getValues(), Vmax1);
-        m_IPR_q[iRound][iGame] = computeIPR(oDistInst);
-        m_IPR_Q[iRound][iGame] = computeIPR(oDistCum);
-        m_IPR_p[iRound][iGame] = computeIPR(rDistInst);
-        m_IPR_P[iRound][iGame] = computeIPR(rDistCum);
-        m_F_Q[iRound][iGame] = computeF(oDistCum, game.m_map.getValues());
-        m_F_P[iRound][iGame] = computeF(rDistCum, game.m_map.getValues());
+        sinceStart.values[iVisited] = map.getValue(visitedCells[iVisited]);
     }
-}
-
-void GameAnalyzer::computeValuesBestCells(int iGame, const Agent &agent)
-{
-    for (int iRound{0}; iRound < m_numberOfRounds; ++iRound)
+    sinceStart.visits.assign(numberOfVisitedCells, 0);
+    sinceStart.ratings.assign(numberOfVisitedCells, 0);
+
+    // The cells of a round are stored as all the cells of the game, those not visited during the round
+    // having no visit
+    VisitedCells round{sinceStart};
+    std::vector<double> distribution;
+    for (int iRound{0}; iRound < dimensions.numberOfRounds(); ++iRound)
     {
-        for (int iTurn{0}; iTurn < m_numberOfTurns; ++iTurn)
+        std::fill(round.visits.begin(), round.visits.end(), 0);
+        std::fill(round.ratings.begin(), round.ratings.end(), 0);
+        for (auto iAgent : m_iAgents)
         {
-            m_V[iTurn][iRound][iGame] += agent.m_bestCells[iRound][iTurn].value / static_cast<double>(m_numberOfPlayersToAnalyze);
+            const GameHistory::RoundView moves{history.getRound(iAgent, iRound, dimensions.numberOfTurns())};
+            for (int iTurn{0}; iTurn < dimensions.numberOfTurns(); ++iTurn)
+            {
+                const int iVisited{static_cast<int>(
+                    std::lower_bound(visitedCells.begin(), visitedCells.end(), moves.getCell(iTurn)) -
+                    visitedCells.begin())};
+                const int rCell{moves.getRating(iTurn)};
+
+                ++round.visits[iVisited];
+                round.ratings[iVisited] += rCell;
+                ++sinceStart.visits[iVisited];
+                sinceStart.ratings[iVisited] += rCell;
+            }
         }
+        recordDistributions(iGame, iRound, map, round, sinceStart, distribution);
     }
 }
 
-void GameAnalyzer::computeValuesBestCellsSinceStart(int iGame, const Agent &agent)
+void GameAnalyzer::recordDistributions(int iGame, int iRound, const Map &map, const VisitedCells &round,
+                                       const VisitedCells &sinceStart, std::vector<double> &distribution)
 {
-    std::vector<Cell> bestCells(m_numberOfTurns, {-1, -1});
-    for (int iRound{0}; iRound < m_numberOfRounds; ++iRound)
-    {
-        for (const auto &cellPlayed : agent.m_bestCells[iRound])
-        {
-            for (int i{0}; i < m_numberOfTurns; ++i)
-            {
-                if (cellPlayed.index == bestCells[i].index)
-                {
-                    break;
-                }
-                if (cellPlayed.value > bestCells[i].value)
-                {
-                    bestCells.insert(bestCells.begin() + i, cellPlayed);
-                    bestCells.pop_back();
-                    break;
-                }
-            }
-        }
+    // A visit is compared to the best mean value of the cells opened in a round, a rating to the best value
+    const double visitNormalization{map.getSumOfBestValues(m_numberOfTurns) / static_cast<double>(m_numberOfTurns)};
+    const double ratingNormalization{static_cast<double>(map.getMaxValue())};
+
+    distribution.resize(round.cells.size());
+    normalize(round.visits, distribution);
+    m_q[iRound][iGame] = computePerf(distribution, round.values, visitNormalization);
+    m_IPR_q[iRound][iGame] = computeIPR(distribution);
+
+    normalize(round.ratings, distribution);
+    m_p[iRound][iGame] = computePerf(distribution, round.values, ratingNormalization);
+    m_IPR_p[iRound][iGame] = computeIPR(distribution);
+
+    distribution.resize(sinceStart.cells.size());
+    normalize(sinceStart.visits, distribution);
+    m_Q[iRound][iGame] = computePerf(distribution, sinceStart.values, visitNormalization);
+    m_IPR_Q[iRound][iGame] = computeIPR(distribution);
+    m_F_Q[iRound][iGame] = computeF(distribution, sinceStart.values, map);
+
+    normalize(sinceStart.ratings, distribution);
+    m_P[iRound][iGame] = computePerf(distribution, sinceStart.values, ratingNormalization);
+    m_IPR_P[iRound][iGame] = computeIPR(distribution);
+    m_F_P[iRound][iGame] = computeF(distribution, sinceStart.values, map);
+}
 
-        for (int iTurn{0}; iTurn < m_numberOfTurns; ++iTurn)
-        {
-            m_VB[iTurn][iRound][iGame] += bestCells[iTurn].value / static_cast<double>(m_numberOfPlayersToAnalyze);
-        }
-    }
+GameAnalyzer::AgentProgress::AgentProgress(int numberOfTurns)
+    : bestCellsSinceStart(numberOfTurns, Cell{-1, -1}),
+      bestCellsPlayed{},
+      numberOfCellsFound{}
+{
+}
+
+void GameAnalyzer::AgentProgress::reset()
+{
+    std::fill(bestCellsSinceStart.begin(), bestCellsSinceStart.end(), Cell{-1, -1});
+    bestCellsPlayed.clear();
+    numberOfCellsFound.fill(0);
 }
 
-void GameAnalyzer::computeReplayBestCells(int iGame, const Agent &agent)
+template <typename Cells>
+void GameAnalyzer::recordBestCells(int iGame, int iRound, const Map &map, const Cells &bestCells,
+                                   const Cells &previousBestCells, AgentProgress &progress)
 {
-    std::vector<std::vector<int>> playBestCellsRound(m_numberOfTurns, std::vector<int>(m_numberOfRounds, 0));
-    for (int iRound{1}; iRound < m_numberOfRounds; ++iRound)
+    const int numberOfTurns{static_cast<int>(bestCells.size())};
+
+    // Values of the best cells of the round
+    for (int iTurn{0}; iTurn < numberOfTurns; ++iTurn)
+    {
+        m_V[iTurn][iRound][iGame] += bestCells[iTurn].value / static_cast<double>(m_numberOfPlayersToAnalyze);
+    }
+
+    // Values of the best cells since the start
+    std::vector<Cell> &bestCellsSinceStart{progress.bestCellsSinceStart};
+    for (const auto &cellPlayed : bestCells)
+    {
+        BestCells::insertUnique(bestCellsSinceStart.begin(), bestCellsSinceStart.end(), cellPlayed);
+    }
+    for (int iTurn{0}; iTurn < numberOfTurns; ++iTurn)
     {
-        for (auto &cellPlayed : agent.m_bestCells[iRound])
+        m_VB[iTurn][iRound][iGame] += bestCellsSinceStart[iTurn].value / static_cast<double>(m_numberOfPlayersToAnalyze);
+    }
+
+    // Replays of the best cells of the previous round
+    if (iRound > 0)
+    {
+        for (const auto &cellPlayed : bestCells)
         {
-            for (int iTurn{0}; iTurn < m_numberOfTurns; ++iTurn)
+            for (int iTurn{0}; iTurn < numberOfTurns; ++iTurn)
             {
-                if (cellPlayed.index == agent.m_bestCells[iRound - 1][iTurn].index)
+                if (cellPlayed.index == previousBestCells[iTurn].index)
                 {
                     m_B[iTurn][iRound][iGame] += 1 / static_cast<double>(m_numberOfPlayersToAnalyze);
                 }
             }
         }
     }
-}
 
-void GameAnalyzer::computeFindBestCells(int iGame, const Agent &agent)
-{ // TODO: do not work if the game is not sorted
-    std::vector<std::vector<bool>> findings(m_numberOfRounds, std::vector<bool>(m_numberOfCells, false));
-    for (int iRound{0}; iRound < m_numberOfRounds; ++iRound)
+    // Discoveries of the cells of the tiers, a cell only counting if it was not among the best cells before
+    for (const auto &cellPlayed : bestCells)
     {
-        for (auto &cell : agent.m_bestCells[iRound])
+        const int iTier{cellPlayed.index < 0 ? -1 : map.getTier(cellPlayed.index)};
+        if (iTier >= 0 && std::find(progress.bestCellsPlayed.begin(), progress.bestCellsPlayed.end(),
+                                    cellPlayed.index) == progress.bestCellsPlayed.end())
         {
-            if (!findings[iRound][cell.index])
-            {
-                for (int iRound2{iRound}; iRound2 < m_numberOfRounds; ++iRound2)
-                {
-                    findings[iRound2][cell.index] = true;
-                }
-            }
+            ++progress.numberOfCellsFound[iTier];
         }
+        progress.bestCellsPlayed.push_back(cellPlayed.index);
     }
 
-    for (int iRound{0}; iRound < m_numberOfRounds; ++iRound)
+    // For larger maps, the indicators are summed over the blocks of 225 cells
+    for (int iTier{0}; iTier < Map::numberOfTiers; ++iTier)
     {
-        for (int i{0}; i < m_numberOfCells / 225; ++i) // for larger maps
-        {
-            m_find[0][iRound][iGame] += findings[iRound][i * 225 + 0] /
-                                        static_cast<double>(m_numberOfPlayersToAnalyze);
-            m_find[1][iRound][iGame] += (findings[iRound][i * 225 + 1] +
-                                         findings[iRound][i * 225 + 2] +
-                                         findings[iRound][i * 225 + 3] +
-                                         findings[iRound][i * 225 + 4]) /
-                                        static_cast<double>(4 * m_numberOfPlayersToAnalyze);
-            m_find[2][iRound][iGame] += (findings[iRound][i * 225 + 5] +
-                                         findings[iRound][i * 225 + 6] +
-                                         findings[iRound][i * 225 + 7] +
-                                         findings[iRound][i * 225 + 8]) /
-                                        static_cast<double>(4 * m_numberOfPlayersToAnalyze);
-        }
+        m_find[iTier][iRound][iGame] += progress.numberOfCellsFound[iTier] /
+                                        static_cast<double>(Map::getTierSizePerBlock(iTier) * m_numberOfPlayersToAnalyze);
     }
 }
 
-void GameAnalyzer::computeScore(int iGame, const Game &game, int iAgent, int iAgentToAnalyze)
+template <typename Scores>
+void GameAnalyzer::computeScore(int iGame, const Map &map, const Scores &scores, int iAgent, int iAgentToAnalyze)
 {
-    const int Smax{(99 + 86 + 86) * game.m_numberOfRounds}; // TODO: change that
+    const int Smax{map.getSumOfBestValues(m_numberOfTurns) * m_numberOfRounds};
 
-    const double normalizedScore{game.getScoreOfPlayer(iAgent) / static_cast<double>(Smax)};
+    const double normalizedScore{scores[iAgent] / static_cast<double>(Smax)};
     m_S[iGame * m_numberOfPlayersToAnalyze + iAgentToAnalyze] = normalizedScore;
     m_S_group[iGame] += normalizedScore / m_numberOfPlayersToAnalyze;
 }
 
-void GameAnalyzer::computeRank(int iGame, const Game &game, int iAgent, int iAgentToAnalyze)
+template <typename Scores>
+void GameAnalyzer::computeRank(int iGame, const Scores &scores, int iAgent, int iAgentToAnalyze)
 {
     m_rank[iGame * m_numberOfPlayersToAnalyze + iAgentToAnalyze] = 1;
-    for (int iOtherAgent{0}; iOtherAgent < game.m_numberOfPlayers; ++iOtherAgent)
+    for (int iOtherAgent{0}; iOtherAgent < scores.size(); ++iOtherAgent)
     {
         if (iOtherAgent != iAgent)
         {
-            if (game.getScoreOfPlayer(iOtherAgent) > game.getScoreOfPlayer(iAgent))
+            if (scores[iOtherAgent] > scores[iAgent])
             {
                 ++m_rank[iGame * m_numberOfPlayersToAnalyze + iAgentToAnalyze];
             }
@@ -325,21 +376,25 @@ void GameAnalyzer::computeRank(int iGame, const Game &game, int iAgent, int iAge
     }
 }
 
-void GameAnalyzer::computeMNS(int iGame, const Game &game, int iAgent)
+template <typename Dimensions>
+void GameAnalyzer::computeMNS(int iGame, const Dimensions &dimensions, const GameHistory &history, int iAgent)
 {
-    for (int iRound{0}; iRound < m_numberOfRounds; ++iRound)
+    const std::lock_guard<std::mutex> lock(m_MNS_mutex);
+    for (int iRound{0}; iRound < dimensions.numberOfRounds(); ++iRound)
     {
-        for (int iTurn{0}; iTurn < m_numberOfTurns; ++iTurn)
+        const GameHistory::RoundView round{history.getRound(iAgent, iRound, dimensions.numberOfTurns())};
+        for (int iTurn{0}; iTurn < dimensions.numberOfTurns(); ++iTurn)
         {
-            const int vCell{game.m_vCellOpened[iAgent][iRound][iTurn]};
-            const int rCell{game.m_rCellOpened[iAgent][iRound][iTurn]};
+            const int vCell{round.getValue(iTurn)};
+            const int rCell{round.getRating(iTurn)};
             m_MNS_ratings[vCell] += rCell;
             m_MNS_counts[vCell]++;
         }
     }
 }
 
-double GameAnalyzer::computePerf(const std::vector<double> &distribution, const std::vector<int> &values, double normalization)
+template <typename Distribution>
+double GameAnalyzer::computePerf(const Distribution &distribution, const std::vector<int> &values, double normalization)
 {
     double perf{0.};
     for (int iCell{0}; iCell < distribution.size(); ++iCell)
@@ -349,7 +404,8 @@ double GameAnalyzer::computePerf(const std::vector<double> &distribution, const
     return perf / normalization;
 }
 
-double GameAnalyzer::computeIPR(const std::vector<double> &distribution)
+template <typename Distribution>
+double GameAnalyzer::computeIPR(const Distribution &distribution)
 {
     double sumSquared{0.};
     for (const auto &value : distribution)
@@ -359,30 +415,32 @@ double GameAnalyzer::computeIPR(const std::vector<double> &distribution)
     return sumSquared == 0. ? 0. : 1. / sumSquared;
 }
 
-double GameAnalyzer::computeF(const std::vector<double> &distribution, const std::vector<int> &values)
+template <typename Distribution>
+double GameAnalyzer::computeF(const Distribution &distribution, const std::vector<int> &values, const Map &map)
 {
     double sumSqrt{0.};
-    int sumValues{0};
     for (int iCell{0}; iCell < distribution.size(); ++iCell)
     {
-        sumValues += values[iCell];
         sumSqrt += std::sqrt(distribution[iCell] * values[iCell]);
     }
-    return sumSqrt / std::sqrt(sumValues);
+    return sumSqrt / std::sqrt(map.getSumOfValues());
 }
 
-std::vector<double> GameAnalyzer::normalize(const std::vector<int> &vector)
+template <typename Counts, typename Distribution>
+void GameAnalyzer::normalize(const Counts &counts, Distribution &distribution)
 {
-    const double sum{std::accumulate(vector.begin(), vector.end(), 0.)};
-    std::vector<double> normalizedVector(vector.size(), 0.);
-    if (sum != 0.)
+    const double sum{std::accumulate(counts.begin(), counts.end(), 0.)};
+    if (sum == 0.)
     {
-        for (int i{0}; i < vector.size(); ++i)
+        std::fill(distribution.begin(), distribution.end(), 0.);
+    }
+    else
+    {
+        for (int i{0}; i < counts.size(); ++i)
         {
-            normalizedVector[i] = vector[i] / sum;
+            distribution[i] = counts[i] / sum;
         }
     }
-    return normalizedVector;
 }
 
 std::vector<double> GameAnalyzer::divide(const std::vector<int> &numerator, const std::vector<int> &denominator)
@@ -447,3 +505,136 @@ void GameAnalyzer::saveObservable(const std::string &observablePath, double obse
 {
     saveObservable(observablePath, std::vector<double>{observable});
 }
+
+GameAnalyzer::Recorder::Recorder(GameAnalyzer &analyzer)
+    : m_analyzer{analyzer},
+      m_iGame{0},
+      m_roundMoves{},
+      m_round{},
+      m_sinceStart{},
+      m_merged{},
+      m_distribution{},
+      m_bestCells(analyzer.m_iAgents.size(), BestCells(analyzer.m_numberOfRounds, analyzer.m_numberOfTurns)),
+      m_progress(analyzer.m_iAgents.size(), AgentProgress(analyzer.m_numberOfTurns)),
+      m_MNS_ratings(analyzer.m_MNS_ratings.size(), 0),
+      m_MNS_counts(analyzer.m_MNS_counts.size(), 0)
+{
+    if (!m_analyzer.m_isInitialized)
+    {
+        throw std::runtime_error("The analyzer must be initialized before a recorder is built.");
+    }
+    m_roundMoves.reserve(m_analyzer.m_iAgents.size() * m_analyzer.m_numberOfTurns);
+}
+
+void GameAnalyzer::Recorder::startGame(int iGame)
+{
+    m_iGame = iGame;
+    m_sinceStart.cells.clear();
+    m_sinceStart.values.clear();
+    m_sinceStart.visits.clear();
+    m_sinceStart.ratings.clear();
+    for (auto &progress : m_progress)
+    {
+        progress.reset();
+    }
+    std::fill(m_MNS_ratings.begin(), m_MNS_ratings.end(), 0);
+    std::fill(m_MNS_counts.begin(), m_MNS_counts.end(), 0);
+}
+
+void GameAnalyzer::Recorder::onRoundChanged(const Game &game, int iRound)
+{
+    const Map &map{game.getMap()};
+    const GameHistory &history{game.getHistory()};
+
+    // Visits and stars of the cells of the round, sorted by cell index
+    m_roundMoves.clear();
+    for (auto iAgent : m_analyzer.m_iAgents)
+    {
+        const GameHistory::RoundView moves{history.getRound(iAgent, iRound)};
+        for (int iTurn{0}; iTurn < moves.size(); ++iTurn)
+        {
+            m_roundMoves.emplace_back(moves.getCell(iTurn), moves.getRating(iTurn));
+            m_MNS_ratings[moves.getValue(iTurn)] += moves.getRating(iTurn);
+            m_MNS_counts[moves.getValue(iTurn)]++;
+        }
+    }
+    std::sort(m_roundMoves.begin(), m_roundMoves.end());
+    m_round.cells.clear();
+    m_round.values.clear();
+    m_round.visits.clear();
+    m_round.ratings.clear();
+    for (const auto &[iCell, rating] : m_roundMoves)
+    {
+        if (m_round.cells.empty() || m_round.cells.back() != iCell)
+        {
+            m_round.cells.push_back(iCell);
+            m_round.values.push_back(map.getValue(iCell));
+            m_round.visits.push_back(0);
+            m_round.ratings.push_back(0);
+        }
+        ++m_round.visits.back();
+        m_round.ratings.back() += rating;
+    }
+    mergeVisitedCells();
+    m_analyzer.recordDistributions(m_iGame, iRound, map, m_round, m_sinceStart, m_distribution);
+
+    // Best cells of the round of each analyzed agent, sorted as by `Agent`
+    for (int iAgentToAnalyze{0}; iAgentToAnalyze < m_analyzer.m_iAgents.size(); ++iAgentToAnalyze)
+    {
+        const GameHistory::RoundView moves{history.getRound(m_analyzer.m_iAgents[iAgentToAnalyze], iRound)};
+        BestCells &bestCells{m_bestCells[iAgentToAnalyze]};
+        bestCells.record(iRound, moves);
+        m_analyzer.recordBestCells(m_iGame, iRound, map, bestCells[iRound], bestCells[iRound > 0 ? iRound - 1 : 0],
+                                   m_progress[iAgentToAnalyze]);
+    }
+
+    if (iRound == m_analyzer.m_numberOfRounds - 1)
+    {
+        for (int iAgentToAnalyze{0}; iAgentToAnalyze < m_analyzer.m_iAgents.size(); ++iAgentToAnalyze)
+        {
+            const int iAgent{m_analyzer.m_iAgents[iAgentToAnalyze]};
+            m_analyzer.computeScore(m_iGame, map, game.getScores(), iAgent, iAgentToAnalyze);
+            m_analyzer.computeRank(m_iGame, game.getScores(), iAgent, iAgentToAnalyze);
+        }
+
+        // The histogram of the analyzer is shared by the recorders of all the threads
+        const std::lock_guard<std::mutex> lock(m_analyzer.m_MNS_mutex);
+        for (int value{0}; value < static_cast<int>(m_MNS_ratings.size()); ++value)
+        {
+            m_analyzer.m_MNS_ratings[value] += m_MNS_ratings[value];
+            m_analyzer.m_MNS_counts[value] += m_MNS_counts[value];
+        }
+    }
+}
+
+void GameAnalyzer::Recorder::mergeVisitedCells()
+{
+    m_merged.cells.clear();
+    m_merged.values.clear();
+    m_merged.visits.clear();
+    m_merged.ratings.clear();
+    std::size_t iRound{0};
+    std::size_t iSinceStart{0};
+    while (iRound < m_round.cells.size() || iSinceStart < m_sinceStart.cells.size())
+    {
+        const bool takeRound{iSinceStart == m_sinceStart.cells.size() ||
+                             (iRound < m_round.cells.size() && m_round.cells[iRound] <= m_sinceStart.cells[iSinceStart])};
+        const bool takeSinceStart{iRound == m_round.cells.size() ||
+                                  (iSinceStart < m_sinceStart.cells.size() &&
+                                   m_sinceStart.cells[iSinceStart] <= m_round.cells[iRound])};
+        const VisitedCells &source{takeRound ? m_round : m_sinceStart};
+        const std::size_t iSource{takeRound ? iRound : iSinceStart};
+        m_merged.cells.push_back(source.cells[iSource]);
+        m_merged.values.push_back(source.values[iSource]);
+        m_merged.visits.push_back((takeRound ? m_round.visits[iRound] : 0) +
+                                  (takeSinceStart ? m_sinceStart.visits[iSinceStart] : 0));
+        m_merged.ratings.push_back((takeRound ? m_round.ratings[iRound] : 0) +
+                                   (takeSinceStart ? m_sinceStart.ratings[iSinceStart] : 0));
+        iRound += takeRound;
+        iSinceStart += takeSinceStart;
+    }
+    std::swap(m_merged, m_sinceStart);
+}
+
+template void GameAnalyzer::analyzeGame(int, const BasicGameBatch<DynamicDimensions> &, int);
+template void GameAnalyzer::analyzeGame(int, const BasicGameBatch<ExperimentDimensions> &, int);
@@ -1,10 +1,22 @@
 #ifndef GAME_ANALYZER_H
 #define GAME_ANALYZER_H
 
+#include <array>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include "agent/Agent.h"
+#include "agent/BestCells.h"
+#include "agent/Cell.h"
+#include "game/Dimensions.h"
 #include "game/Game.h"
+#include "game/GameHistory.h"
+#include "game/GameObserver.h"
+#include "game/Map.h"
+
+template <typename Dimensions>
+class BasicGameBatch;
 
 /**
  * @brief Aggregates observables computed over many games.
@@ -13,10 +25,15 @@
  * agent indices to analyze. For each game, `analyzeGame()` records per-game observables (visit and
  * rating distributions, best-cell values, discovery times, scores, ranks, MNS, ...). Getters return
  * the observables averaged over games; `saveObservables()` writes them to disk.
+ *
+ * The games played with `Game` can also be analyzed while they are played, by attaching a `Recorder` to
+ * them, which gives the same observables as `analyzeGame()` without scanning the games once they are over.
  */
 class GameAnalyzer
 {
 public:
+    class Recorder;
+
     /**
      * @brief Build an analyzer that tracks specific agents.
      *
@@ -45,6 +62,18 @@ public:
      */
     void initialize(int numberOfRounds, int numberOfTurns, int numberOfCells);
 
+    /**
+     * @brief Allocate the internal per-game buffers for games played on maps like `map`.
+     *
+     * Must be called exactly once, before the first call to `analyzeGame()` and
+     * before any parallel region.
+     *
+     * @param numberOfRounds Number of rounds per game.
+     * @param numberOfTurns  Number of turns per round.
+     * @param map A map with the same number of cells and values as the maps of the analyzed games.
+     */
+    void initialize(int numberOfRounds, int numberOfTurns, const Map &map);
+
     /**
      * @brief Record the observables of a single game.
      *
@@ -56,6 +85,20 @@ public:
      */
     void analyzeGame(int iGame, const Game &game, const std::vector<Agent> &agents);
 
+    /**
+     * @brief Record the observables of a single game played within a batch.
+     *
+     * `initialize()` must have been called before the first invocation.
+     *
+     * @param iGame Index of the game (must be in [0, numberOfGames)).
+     * @tparam Dimensions The dimensions of the batch, `DynamicDimensions` or `ExperimentDimensions`. With the
+     *         latter, the analysis uses the same constant loop bounds and fixed-size buffers as the batch.
+     * @param batch The finished batch of games.
+     * @param iGameInBatch Index of the game to analyze within the batch.
+     */
+    template <typename Dimensions>
+    void analyzeGame(int iGame, const BasicGameBatch<Dimensions> &batch, int iGameInBatch);
+
     /**
      * @brief Write all averaged observables to files under the given directory.
      *
@@ -123,6 +166,37 @@ public:
     std::vector<double> get_MNS() const;
 
 private:
+    /**
+     * @brief The visits and the stars of the cells visited by the analyzed agents, sorted by cell index.
+     */
+    struct VisitedCells
+    {
+        std::vector<int> cells;
+        std::vector<int> values;
+        std::vector<int> visits;
+        std::vector<int> ratings;
+    };
+
+    /**
+     * @brief The best cells of an analyzed agent in the rounds already recorded.
+     */
+    struct AgentProgress
+    {
+        explicit AgentProgress(int numberOfTurns);
+
+        /**
+         * @brief Forget the cells recorded, before a new game, keeping the storage.
+         */
+        void reset();
+
+        // Best cells of all the rounds, sorted by decreasing value
+        std::vector<Cell> bestCellsSinceStart;
+        // Best cells of each round, by round then by turn
+        std::vector<int> bestCellsPlayed;
+        // Number of cells of each tier found
+        std::array<int, Map::numberOfTiers> numberOfCellsFound;
+    };
+
     /**
      * @brief Allocate the internal per-game buffers using the game's parameters.
      *
@@ -132,35 +206,88 @@ private:
 
     /**
      * @brief Allocate the internal per-game buffers from already-set dimension members.
+     *
+     * @param maxValue The highest value of the maps of the analyzed games.
+     */
+    void initializeBuffers(int maxValue);
+
+    /**
+     * @brief Record the observables of one analyzed agent of a game.
+     *
+     * The analysis functions are templates on the dimensions of the games, so that the analysis of games of
+     * fixed dimensions uses constant loop bounds and fixed-size buffers, and on the containers of the scores
+     * and of the best cells, which depend on the engine that played the game.
+     *
+     * @param iGame Index of the game.
+     * @param dimensions The dimensions of the game.
+     * @param history The moves of the game.
+     * @param map The map of the game.
+     * @param scores The final score of each player of the game.
+     * @param bestCells The best cells of each round of the agent, indexed by round then by turn.
+     * @param iAgent Index of the agent in the game.
+     * @param iAgentToAnalyze Index of the agent among the analyzed ones.
+     */
+    template <typename Dimensions, typename Scores, typename BestCells>
+    void analyzeAgent(int iGame, const Dimensions &dimensions, const GameHistory &history, const Map &map,
+                      const Scores &scores, const BestCells &bestCells, int iAgent, int iAgentToAnalyze);
+
+    /**
+     * @brief Compute visit and rating distributions (instantaneous and cumulative) for a game.
+     *
+     * The distributions are computed on the cells visited during the game only, so that the cost does not
+     * depend on the size of the map.
      */
-    void initializeBuffers();
-
-    /** @brief Compute visit and rating distributions (instantaneous and cumulative) for a game. */
-    void computeDistributions(int iGame, const Game &game);
-    /** @brief Accumulate the values of the best cells played each turn/round for an agent. */
-    void computeValuesBestCells(int iGame, const Agent &agent);
-    /** @brief Accumulate the values of the best cells found since the start for an agent. */
-    void computeValuesBestCellsSinceStart(int iGame, const Agent &agent);
-    /** @brief Accumulate the replay indicator: did the agent replay the best cells of the previous round? */
-    void computeReplayBestCells(int iGame, const Agent &agent);
-    /** @brief Accumulate the discovery indicators for the top-tier cells of the map. */
-    void computeFindBestCells(int iGame, const Agent &agent);
+    template <typename Dimensions>
+    void computeDistributions(int iGame, const Dimensions &dimensions, const GameHistory &history, const Map &map);
+    /**
+     * @brief Record the performances, IPR and fidelities of the visit and rating distributions of a round.
+     *
+     * @param round The cells visited during the round.
+     * @param sinceStart The cells visited since the start of the game, up to the round included.
+     * @param distribution Buffer for the distributions, resized as needed.
+     */
+    void recordDistributions(int iGame, int iRound, const Map &map, const VisitedCells &round,
+                             const VisitedCells &sinceStart, std::vector<double> &distribution);
+    /**
+     * @brief Record the observables of the best cells of a round of one agent: their values, the values of
+     * the best cells since the start, the replays of the best cells of the previous round and the discovery
+     * of the best cells of the map.
+     *
+     * The best cells of the map are found from the ranks of the values of the map of the game, so that the
+     * discovery is measured the same way on shuffled maps, whatever the positions of the best cells.
+     *
+     * @param bestCells The best cells of the round, sorted by decreasing value.
+     * @param previousBestCells The best cells of the previous round, ignored for the first round.
+     * @param progress The best cells of the agent in the previous rounds, updated with those of the round.
+     */
+    template <typename Cells>
+    void recordBestCells(int iGame, int iRound, const Map &map, const Cells &bestCells, const Cells &previousBestCells,
+                         AgentProgress &progress);
     /** @brief Record the normalized individual and group scores for one agent of one game. */
-    void computeScore(int iGame, const Game &game, int iAgent, int iAgentToAnalyze);
+    template <typename Scores>
+    void computeScore(int iGame, const Map &map, const Scores &scores, int iAgent, int iAgentToAnalyze);
     /** @brief Record the rank (1 = best) of one agent within one game. */
-    void computeRank(int iGame, const Game &game, int iAgent, int iAgentToAnalyze);
-    /** @brief Accumulate the mean-number-of-stars histogram for one agent of one game. */
-    void computeMNS(int iGame, const Game &game, int iAgent);
+    template <typename Scores>
+    void computeRank(int iGame, const Scores &scores, int iAgent, int iAgentToAnalyze);
+    /**
+     * @brief Accumulate the mean-number-of-stars histogram for one agent of one game.
+     *
+     * The histogram is shared by all the games, so it is updated under `m_MNS_mutex` to allow the games to
+     * be analyzed in parallel.
+     */
+    template <typename Dimensions>
+    void computeMNS(int iGame, const Dimensions &dimensions, const GameHistory &history, int iAgent);
 
     /**
      * @brief Compute a normalized performance from a distribution and the underlying cell values.
      *
      * @param distribution Probability of visiting/rating each cell.
-     * @param values The value of each cell.
+     * @param values The value of each cell of `distribution`.
      * @param normalization Divisor applied to the raw expected value.
      * @return The normalized performance.
      */
-    static double computePerf(const std::vector<double> &distribution, const std::vector<int> &values, double normalization);
+    template <typename Distribution>
+    static double computePerf(const Distribution &distribution, const std::vector<int> &values, double normalization);
 
     /**
      * @brief Compute the inverse participation ratio of a distribution.
@@ -168,24 +295,29 @@ private:
      * @param distribution Probability of visiting/rating each cell.
      * @return `1 / sum(p^2)`, or 0 if the distribution is null.
      */
-    static double computeIPR(const std::vector<double> &distribution);
+    template <typename Distribution>
+    static double computeIPR(const Distribution &distribution);
 
     /**
      * @brief Compute the fidelity F of a distribution relative to the map values.
      *
      * @param distribution Probability of visiting/rating each cell.
-     * @param values The value of each cell.
-     * @return `sum(sqrt(p*v)) / sqrt(sum(v))`.
+     * @param values The value of each cell of `distribution`.
+     * @param map The map of the game, whose values give the normalization.
+     * @return `sum(sqrt(p*v)) / sqrt(sum(v))`, the second sum being over all the cells of the map.
      */
-    static double computeF(const std::vector<double> &distribution, const std::vector<int> &values);
+    template <typename Distribution>
+    static double computeF(const Distribution &distribution, const std::vector<int> &values, const Map &map);
 
     /**
-     * @brief Normalize an integer vector so that its entries sum to 1.
+     * @brief Normalize integer counts so that they sum to 1.
      *
-     * @param vector The vector to normalize.
-     * @return The normalized vector, or a vector of zeros if the input sums to 0.
+     * @param counts The counts to normalize.
+     * @param distribution Output, of the same size as `counts`: the normalized counts, or zeros if the
+     *        counts sum to 0.
      */
-    static std::vector<double> normalize(const std::vector<int> &vector);
+    template <typename Counts, typename Distribution>
+    static void normalize(const Counts &counts, Distribution &distribution);
 
     /**
      * @brief Element-wise division of two integer vectors, returning NaN where the denominator is 0.
@@ -268,6 +400,65 @@ private:
     std::vector<double> m_S;
     std::vector<double> m_S_group;
     std::vector<double> m_rank;
+    // Stars given and number of openings per cell value, summed over all the games
+    std::vector<int> m_MNS_ratings;
+    std::vector<int> m_MNS_counts;
+    std::mutex m_MNS_mutex;
+};
+
+/**
+ * @brief Observer of a `Game` that records the observables of its games into an analyzer while they are played.
+ *
+ * The observables of a round are recorded when the round is over, from the moves of the round which are
+ * still in cache, and the scores and ranks when the game is over. Only the changes of round are observed,
+ * so that the agents of the game may play their rounds in parallel. Each thread attaches its own recorder to
+ * its own game: the observables of a game are stored at the index of the game, and the MNS histogram, which
+ * is shared by the games, is summed by the recorder over its game and added to that of the analyzer under a
+ * lock when the game is over.
+ *
+ *     GameAnalyzer::Recorder recorder(analyzer);
+ *     game.addObserver(recorder);
+ *     // for each game: game.reset(), recorder.startGame(iGame), then play the game
+ */
+class GameAnalyzer::Recorder : public GameObserver
+{
+public:
+    /**
+     * @brief Build a recorder of the observables of games.
+     *
+     * @param analyzer The analyzer, which must be initialized and outlive the recorder.
+     */
+    explicit Recorder(GameAnalyzer &analyzer);
+
+    /**
+     * @brief Record the next game into the given game index.
+     *
+     * Must be called before the first move of each game.
+     *
+     * @param iGame Index of the game (must be in [0, numberOfGames)).
+     */
+    void startGame(int iGame);
+
+    void onRoundChanged(const Game &game, int iRound) override;
+
+private:
+    /**
+     * @brief Merge the cells visited during the round into the cells visited since the start of the game.
+     */
+    void mergeVisitedCells();
+
+    GameAnalyzer &m_analyzer;
+    int m_iGame;
+    // Visited cells of the round and since the start, and buffers
+    std::vector<std::pair<int, int>> m_roundMoves;
+    VisitedCells m_round;
+    VisitedCells m_sinceStart;
+    VisitedCells m_merged;
+    std::vector<double> m_distribution;
+    // Best cells of each analyzed agent during the rounds of the game
+    std::vector<BestCells> m_bestCells;
+    std::vector<AgentProgress> m_progress;
+    // Stars given and number of openings per cell value during the game
     std::vector<int> m_MNS_ratings;
     std::vector<int> m_MNS_counts;
 };
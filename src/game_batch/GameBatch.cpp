@@ -0,0 +1,544 @@
+#include <algorithm> // std::binary_search, std::fill, std::sort, std::unique
+#include <cmath>     // std::isnan, std::nan
+#include <memory>    // std::shared_ptr
+#include <stdexcept> // std::invalid_argument, std::runtime_error
+#include <utility>   // std::move
+#include <vector>    // std::vector
+
+#include "agent/BestCells.h"
+#include "agent/Cell.h"
+#include "agent/RatingStrategy.h"
+#include "game/Dimensions.h"
+#include "game/GameHistory.h"
+#include "game/Map.h"
+#include "game/Rule.h"
+#include "game_batch/GameBatch.h"
+#include "math/VectorMath.h"
+#include "random/myRandom.h"
+
+template <typename Dimensions>
+BasicGameBatch<Dimensions>::BasicGameBatch(int batchSize,
+                                           const Dimensions &dimensions,
+                                           const Rule &rule,
+                                           std::shared_ptr<const Map> map,
+                                           double tauEvaporation,
+                                           const std::vector<double> &parametersOpenings,
+                                           const std::vector<RatingStrategy> &ratingStrategies)
+    : //
+      m_batchSize{batchSize},
+      m_dimensions{dimensions},
+      m_rule{rule},
+      mp_map{std::move(map)},
+      m_tauEvaporation{tauEvaporation},
+      //
+      m_exploration{0.},
+      m_exponent{0.},
+      m_replayOffsets{dimensions.template makeTurnArray<double>(0.)},
+      m_replaySlopes{dimensions.template makeTurnArray<double>(0.)},
+      //
+      m_ratingStrategies{ratingStrategies},
+      m_ratings{},
+      m_numberOfRatings{0},
+      m_strategies(batchSize * dimensions.numberOfPlayers(), 0),
+      //
+      m_maps(batchSize, mp_map),
+      //
+      m_iRound{0},
+      m_stars(dimensions.numberOfCells() * batchSize, 0.),
+      m_sumOfStars(batchSize, 0.),
+      m_evaporationScale{1.},
+      m_exploringCumulatives(dimensions.numberOfCells() * batchSize, 0.),
+      m_sumOfPowers(batchSize, 0.),
+      m_uniformWeights(batchSize, 0.),
+      //
+      m_histories(batchSize,
+                  GameHistory(dimensions.numberOfPlayers(), dimensions.numberOfRounds(), dimensions.numberOfTurns())),
+      m_scores(batchSize, dimensions.template makePlayerArray<int>(0)),
+      m_bestCells(batchSize * dimensions.numberOfPlayers(),
+                  dimensions.makeRoundArray(dimensions.template makeTurnArray<Cell>({-1, -1}))),
+      m_roundScores(batchSize * dimensions.numberOfPlayers(), 0),
+      m_numberOfRatingsRemaining(batchSize * dimensions.numberOfPlayers(), rule.getMaxRatingPerRound()),
+      //
+      m_uniforms(batchSize),
+      m_ratingCumulatives(batchSize, nullptr),
+      m_replayValues(batchSize),
+      m_replays(batchSize),
+      m_values(batchSize),
+      m_iRatings(batchSize),
+      m_excludedCells{dimensions.template makeTurnArray<int, 2>(-1)}
+{
+    const int numberOfTurns{dimensions.numberOfTurns()};
+    if (mp_map->getNumberOfCells() != dimensions.numberOfCells())
+    {
+        throw std::invalid_argument("GameBatch: The number of cells of the map does not match the dimensions.");
+    }
+    if (parametersOpenings.size() != 2 + 2 * numberOfTurns)
+    {
+        throw std::invalid_argument("GameBatch: The opening parameters must hold 2 parameters for the exploration "
+                                    "and 2 parameters per turn for the replay of the best cells.");
+    }
+    m_exploration = parametersOpenings[0];
+    m_exponent = parametersOpenings[1];
+    for (int iTurn{0}; iTurn < numberOfTurns; ++iTurn)
+    {
+        m_replayOffsets[iTurn] = parametersOpenings[2 + 2 * iTurn];
+        m_replaySlopes[iTurn] = parametersOpenings[3 + 2 * iTurn];
+    }
+
+    checkRatingStrategies(ratingStrategies);
+    m_ratings = ratingStrategies[0].getRatings();
+    m_numberOfRatings = static_cast<int>(m_ratings.size());
+}
+
+template <typename Dimensions>
+BasicGameBatch<Dimensions>::BasicGameBatch(int batchSize, const Dimensions &dimensions,
+                                           const std::vector<double> &parametersOpenings,
+                                           const std::vector<RatingStrategy> &ratingStrategies)
+    : BasicGameBatch(batchSize, dimensions, Rule(RuleNumber::Rule2), Map::getShared(dimensions.numberOfCells()),
+                     std::nan(""), parametersOpenings, ratingStrategies)
+{
+}
+
+template <typename Dimensions>
+void BasicGameBatch<Dimensions>::checkRatingStrategies(const std::vector<RatingStrategy> &ratingStrategies) const
+{
+    if (ratingStrategies.empty())
+    {
+        throw std::invalid_argument("GameBatch: At least one rating strategy is needed.");
+    }
+    for (const RatingStrategy &ratingStrategy : ratingStrategies)
+    {
+        if (ratingStrategy.getRatings() != ratingStrategies[0].getRatings())
+        {
+            throw std::invalid_argument("GameBatch: All the rating strategies must give the same ratings.");
+        }
+    }
+    if (mp_map->getMaxValue() > RatingStrategy::maxTabulatedValue)
+    {
+        throw std::invalid_argument("GameBatch: The values of the map must be tabulated by the rating strategies.");
+    }
+}
+
+template <typename Dimensions>
+void BasicGameBatch<Dimensions>::reset()
+{
+    m_iRound = 0;
+    std::fill(m_stars.begin(), m_stars.end(), 0.);
+    std::fill(m_sumOfStars.begin(), m_sumOfStars.end(), 0.);
+    m_evaporationScale = 1.;
+    for (int iGame{0}; iGame < m_batchSize; ++iGame)
+    {
+        m_histories[iGame].clear();
+        std::fill(m_scores[iGame].begin(), m_scores[iGame].end(), 0);
+    }
+    std::fill(m_roundScores.begin(), m_roundScores.end(), 0);
+    std::fill(m_numberOfRatingsRemaining.begin(), m_numberOfRatingsRemaining.end(), m_rule.getMaxRatingPerRound());
+    for (auto &bestCells : m_bestCells)
+    {
+        for (auto &bestCellsRound : bestCells)
+        {
+            std::fill(bestCellsRound.begin(), bestCellsRound.end(), Cell{-1, -1});
+        }
+    }
+}
+
+template <typename Dimensions>
+void BasicGameBatch<Dimensions>::setRatingStrategy(int iGame, int iPlayer, int iStrategy)
+{
+    m_strategies[iGame * m_dimensions.numberOfPlayers() + iPlayer] = iStrategy;
+}
+
+template <typename Dimensions>
+void BasicGameBatch<Dimensions>::setMap(int iGame, std::shared_ptr<const Map> map)
+{
+    if (map->getNumberOfCells() != mp_map->getNumberOfCells() || map->getMaxValue() > mp_map->getMaxValue())
+    {
+        throw std::invalid_argument("GameBatch: The map must have the number of cells and the values of the map of "
+                                    "the batch.");
+    }
+    m_maps[iGame] = std::move(map);
+}
+
+template <typename Dimensions>
+void BasicGameBatch<Dimensions>::play()
+{
+    visitRule(m_rule.getRuleNumber(), [this](auto rule) { playWithRule<decltype(rule)>(); });
+}
+
+template <typename Dimensions>
+template <typename RulePolicy>
+void BasicGameBatch<Dimensions>::playWithRule()
+{
+    while (m_iRound < m_dimensions.numberOfRounds())
+    {
+        updateExploringWeights();
+        for (int iPlayer{0}; iPlayer < m_dimensions.numberOfPlayers(); ++iPlayer)
+        {
+            for (int iTurn{0}; iTurn < m_dimensions.numberOfTurns(); ++iTurn)
+            {
+                playATurn<RulePolicy>(iPlayer, iTurn);
+            }
+        }
+        changeRound<RulePolicy>();
+    }
+}
+
+template <typename Dimensions>
+void BasicGameBatch<Dimensions>::updateExploringWeights()
+{
+    const int K{m_batchSize};
+    const int numberOfCells{m_dimensions.numberOfCells()};
+    const double *stars{m_stars.data()};
+    const double *sumOfStars{m_sumOfStars.data()};
+    double *cumulatives{m_exploringCumulatives.data()};
+    double *sumOfPowers{m_sumOfPowers.data()};
+    double *uniformWeights{m_uniformWeights.data()};
+
+    // The powers of the colors are first stored in place of the cumulative weights, and computed at once for
+    // all the cells of all the games
+    for (int iCell{0}; iCell < numberOfCells; ++iCell)
+    {
+#pragma omp simd
+        for (int k = 0; k < K; ++k)
+        {
+            cumulatives[iCell * K + k] = sumOfStars[k] == 0. ? 0. : stars[iCell * K + k] / sumOfStars[k];
+        }
+    }
+    myMath::pow(cumulatives, m_exponent, cumulatives, m_exploringCumulatives.size());
+    std::fill(m_sumOfPowers.begin(), m_sumOfPowers.end(), 0.);
+    for (int iCell{0}; iCell < numberOfCells; ++iCell)
+    {
+#pragma omp simd
+        for (int k = 0; k < K; ++k)
+        {
+            sumOfPowers[k] += cumulatives[iCell * K + k];
+        }
+    }
+
+    // Without any star, the exploration is uniform; otherwise it mixes a uniform part and the powers
+#pragma omp simd
+    for (int k = 0; k < K; ++k)
+    {
+        const bool isEmpty{sumOfStars[k] == 0.};
+        uniformWeights[k] = (isEmpty ? 1. : m_exploration) / numberOfCells;
+        sumOfPowers[k] = isEmpty ? 0. : (1. - m_exploration) / sumOfPowers[k];
+    }
+#pragma omp simd
+    for (int k = 0; k < K; ++k)
+    {
+        cumulatives[k] = uniformWeights[k] + sumOfPowers[k] * cumulatives[k];
+    }
+    for (int iCell{1}; iCell < numberOfCells; ++iCell)
+    {
+#pragma omp simd
+        for (int k = 0; k < K; ++k)
+        {
+            cumulatives[iCell * K + k] = cumulatives[(iCell - 1) * K + k] + uniformWeights[k] +
+                                         sumOfPowers[k] * cumulatives[iCell * K + k];
+        }
+    }
+}
+
+template <typename Dimensions>
+template <typename RulePolicy>
+void BasicGameBatch<Dimensions>::playATurn(int iPlayer, int iTurn)
+{
+    const int K{m_batchSize};
+    const int numberOfPlayers{m_dimensions.numberOfPlayers()};
+    const double *uniforms{m_uniforms.data()};
+
+    // Replay decisions
+    std::fill(m_replays.begin(), m_replays.end(), 0);
+    if (m_iRound > 0)
+    {
+        for (int k{0}; k < K; ++k)
+        {
+            m_uniforms[k] = myRandom::rand();
+            m_replayValues[k] = m_bestCells[k * numberOfPlayers + iPlayer][m_iRound - 1][iTurn].value;
+        }
+        const double offset{m_replayOffsets[iTurn]};
+        const double slope{m_replaySlopes[iTurn]};
+        const double *replayValues{m_replayValues.data()};
+        int *replays{m_replays.data()};
+#pragma omp simd
+        for (int k = 0; k < K; ++k)
+        {
+            replays[k] = uniforms[k] < slope * (replayValues[k] - offset) / 99.;
+        }
+    }
+
+    // Openings
+    for (int k{0}; k < K; ++k)
+    {
+        const int iCell{m_replays[k] ? m_bestCells[k * numberOfPlayers + iPlayer][m_iRound - 1][iTurn].index
+                                     : chooseACellByExploring(k, iPlayer, iTurn)};
+        m_values[k] = m_maps[k]->getValue(iCell);
+        m_histories[k].recordOpening(iPlayer, m_iRound, iTurn, iCell, m_values[k]);
+    }
+
+    // Ratings, drawn as by `RatingStrategy::chooseRating` from the table of the strategy of each player: the
+    // first rating whose running sum reaches the target, or the last rating of positive probability
+    for (int k{0}; k < K; ++k)
+    {
+        const RatingStrategy &ratingStrategy{m_ratingStrategies[m_strategies[k * numberOfPlayers + iPlayer]]};
+        m_ratingCumulatives[k] = ratingStrategy.getCumulatives(m_values[k]);
+        m_uniforms[k] = myRandom::rand() * ratingStrategy.getSumOfProbabilities(m_values[k]);
+        m_iRatings[k] = ratingStrategy.getLastRatingIndex(m_values[k]);
+    }
+    const double *const *ratingCumulatives{m_ratingCumulatives.data()};
+    int *iRatings{m_iRatings.data()};
+#pragma omp simd
+    for (int k = 0; k < K; ++k)
+    {
+        int iRating{iRatings[k]};
+        for (int r{m_numberOfRatings - 1}; r >= 0; --r)
+        {
+            iRating = ratingCumulatives[k][r] >= uniforms[k] ? r : iRating;
+        }
+        iRatings[k] = iRating;
+    }
+
+    // The scores of the turns are accumulated until the change of round
+    for (int k{0}; k < K; ++k)
+    {
+        const int iEntry{k * numberOfPlayers + iPlayer};
+        const int rating{m_ratings[m_iRatings[k]]};
+        m_histories[k].recordRating(iPlayer, m_iRound, iTurn, rating);
+        m_roundScores[iEntry] += RulePolicy::scoreOfTurn(m_values[k], rating);
+        m_numberOfRatingsRemaining[iEntry] -= rating;
+    }
+}
+
+template <typename Dimensions>
+int BasicGameBatch<Dimensions>::chooseACellByExploring(int iGame, int iPlayer, int iTurn)
+{
+    // The cells already played during the round and the best cells of the previous round cannot be explored
+    int numberOfExcludedCells{0};
+    if (m_iRound > 0)
+    {
+        for (const auto &cell : m_bestCells[iGame * m_dimensions.numberOfPlayers() + iPlayer][m_iRound - 1])
+        {
+            m_excludedCells[numberOfExcludedCells++] = cell.index;
+        }
+    }
+    const GameHistory::RoundView cellsPlayed{m_histories[iGame].getRound(iPlayer, m_iRound, iTurn)};
+    for (int iTurnPlayed{0}; iTurnPlayed < cellsPlayed.size(); ++iTurnPlayed)
+    {
+        m_excludedCells[numberOfExcludedCells++] = cellsPlayed.getCell(iTurnPlayed);
+    }
+    const auto excludedBegin{m_excludedCells.begin()};
+    std::sort(excludedBegin, excludedBegin + numberOfExcludedCells);
+    const auto excludedEnd{std::unique(excludedBegin, excludedBegin + numberOfExcludedCells)};
+
+    const int K{m_batchSize};
+    const double *cumulatives{m_exploringCumulatives.data() + iGame};
+    auto cumulativeBefore = [cumulatives, K](int iCell)
+    { return iCell == 0 ? 0. : cumulatives[(iCell - 1) * K]; };
+
+    // Draw in the total weight of the allowed cells, then map the draw to the full cumulative weights by
+    // skipping the weights of the excluded cells that come before it
+    double total{cumulatives[(m_dimensions.numberOfCells() - 1) * K]};
+    for (auto iExcluded{excludedBegin}; iExcluded != excludedEnd; ++iExcluded)
+    {
+        total -= getExploringWeight(*iExcluded, iGame);
+    }
+    double target{myRandom::rand(total)};
+    for (auto iExcluded{excludedBegin}; iExcluded != excludedEnd; ++iExcluded)
+    {
+        if (target < cumulativeBefore(*iExcluded))
+        {
+            break;
+        }
+        target += getExploringWeight(*iExcluded, iGame);
+    }
+
+    // First cell whose cumulative weight exceeds the draw
+    int low{0};
+    int high{m_dimensions.numberOfCells() - 1};
+    while (low < high)
+    {
+        const int middle{(low + high) / 2};
+        if (cumulatives[middle * K] > target)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+
+    // Rounding errors may land the draw on an excluded cell, in which case the nearest allowed one is taken
+    auto isAllowed = [this, iGame, excludedBegin, excludedEnd](int iCell)
+    {
+        return getExploringWeight(iCell, iGame) > 0. && !std::binary_search(excludedBegin, excludedEnd, iCell);
+    };
+    for (int iCell{low}; iCell >= 0; --iCell)
+    {
+        if (isAllowed(iCell))
+        {
+            return iCell;
+        }
+    }
+    for (int iCell{low + 1}; iCell < m_dimensions.numberOfCells(); ++iCell)
+    {
+        if (isAllowed(iCell))
+        {
+            return iCell;
+        }
+    }
+    throw std::runtime_error("GameBatch: No cell can be explored.");
+}
+
+template <typename Dimensions>
+double BasicGameBatch<Dimensions>::getExploringWeight(int iCell, int iGame) const
+{
+    const int K{m_batchSize};
+    const double *cumulatives{m_exploringCumulatives.data() + iGame};
+    return iCell == 0 ? cumulatives[0] : cumulatives[iCell * K] - cumulatives[(iCell - 1) * K];
+}
+
+template <typename Dimensions>
+template <typename RulePolicy>
+void BasicGameBatch<Dimensions>::changeRound()
+{
+    for (int iGame{0}; iGame < m_batchSize; ++iGame)
+    {
+        for (int iPlayer{0}; iPlayer < m_dimensions.numberOfPlayers(); ++iPlayer)
+        {
+            const int iEntry{iGame * m_dimensions.numberOfPlayers() + iPlayer};
+            updateBestCells(iGame, iPlayer);
+            m_scores[iGame][iPlayer] +=
+                m_roundScores[iEntry] + RulePolicy::scoreOfRemainingRatings(m_numberOfRatingsRemaining[iEntry]);
+        }
+    }
+    std::fill(m_roundScores.begin(), m_roundScores.end(), 0);
+    std::fill(m_numberOfRatingsRemaining.begin(), m_numberOfRatingsRemaining.end(), RulePolicy::maxRatingPerRound);
+    updateColors();
+
+    ++m_iRound;
+}
+
+template <typename Dimensions>
+void BasicGameBatch<Dimensions>::updateBestCells(int iGame, int iPlayer)
+{
+    // Same ordering as `BestCells::record` for the agents: by decreasing value, the first opened first among equals
+    const GameHistory::RoundView cellsPlayed{m_histories[iGame].getRound(iPlayer, m_iRound)};
+    auto &bestCells{m_bestCells[iGame * m_dimensions.numberOfPlayers() + iPlayer][m_iRound]};
+    std::fill(bestCells.begin(), bestCells.end(), Cell{-1, -1});
+    for (int iTurn{0}; iTurn < cellsPlayed.size(); ++iTurn)
+    {
+        const Cell cellPlayed{cellsPlayed.getCell(iTurn), cellsPlayed.getValue(iTurn)};
+        ::BestCells::insert(bestCells.begin(), bestCells.end(), cellPlayed);
+    }
+}
+
+template <typename Dimensions>
+void BasicGameBatch<Dimensions>::updateColors()
+{
+    // As in `Game`, the evaporation is applied lazily through a scale factor, common to all the games
+    if (!std::isnan(m_tauEvaporation))
+    {
+        m_evaporationScale *= 1. - 1. / m_tauEvaporation;
+        if (m_evaporationScale < minEvaporationScale)
+        {
+            rescaleStars();
+        }
+    }
+
+    const int K{m_batchSize};
+    for (int iGame{0}; iGame < K; ++iGame)
+    {
+        for (int iPlayer{0}; iPlayer < m_dimensions.numberOfPlayers(); ++iPlayer)
+        {
+            const GameHistory::RoundView round{m_histories[iGame].getRound(iPlayer, m_iRound)};
+            for (int iTurn{0}; iTurn < m_dimensions.numberOfTurns(); ++iTurn)
+            {
+                const double stars{round.getRating(iTurn) / m_evaporationScale};
+                m_stars[round.getCell(iTurn) * K + iGame] += stars;
+                m_sumOfStars[iGame] += stars;
+            }
+        }
+    }
+}
+
+template <typename Dimensions>
+void BasicGameBatch<Dimensions>::rescaleStars()
+{
+    const double scale{m_evaporationScale};
+    double *stars{m_stars.data()};
+    const int size{static_cast<int>(m_stars.size())};
+#pragma omp simd
+    for (int i = 0; i < size; ++i)
+    {
+        stars[i] *= scale;
+    }
+    for (double &sumOfStars : m_sumOfStars)
+    {
+        sumOfStars *= scale;
+    }
+    m_evaporationScale = 1.;
+}
+
+template <typename Dimensions>
+int BasicGameBatch<Dimensions>::getBatchSize() const
+{
+    return m_batchSize;
+}
+
+template <typename Dimensions>
+const Dimensions &BasicGameBatch<Dimensions>::getDimensions() const
+{
+    return m_dimensions;
+}
+
+template <typename Dimensions>
+int BasicGameBatch<Dimensions>::getNumberOfRounds() const
+{
+    return m_dimensions.numberOfRounds();
+}
+
+template <typename Dimensions>
+int BasicGameBatch<Dimensions>::getNumberOfTurns() const
+{
+    return m_dimensions.numberOfTurns();
+}
+
+template <typename Dimensions>
+int BasicGameBatch<Dimensions>::getNumberOfPlayers() const
+{
+    return m_dimensions.numberOfPlayers();
+}
+
+template <typename Dimensions>
+int BasicGameBatch<Dimensions>::getNumberOfCells() const
+{
+    return m_dimensions.numberOfCells();
+}
+
+template <typename Dimensions>
+const Map &BasicGameBatch<Dimensions>::getMap(int iGame) const
+{
+    return *m_maps[iGame];
+}
+
+template <typename Dimensions>
+const GameHistory &BasicGameBatch<Dimensions>::getHistory(int iGame) const
+{
+    return m_histories[iGame];
+}
+
+template <typename Dimensions>
+const typename BasicGameBatch<Dimensions>::Scores &BasicGameBatch<Dimensions>::getScores(int iGame) const
+{
+    return m_scores[iGame];
+}
+
+template <typename Dimensions>
+const typename BasicGameBatch<Dimensions>::BestCells &BasicGameBatch<Dimensions>::getBestCells(int iGame, int iPlayer) const
+{
+    return m_bestCells[iGame * m_dimensions.numberOfPlayers() + iPlayer];
+}
+
+template class BasicGameBatch<DynamicDimensions>;
+template class BasicGameBatch<ExperimentDimensions>;
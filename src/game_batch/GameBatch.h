@@ -0,0 +1,273 @@
+#ifndef GAME_BATCH_H
+#define GAME_BATCH_H
+
+#include <memory>
+#include <vector>
+
+#include "agent/Cell.h"
+#include "agent/RatingStrategy.h"
+#include "game/Dimensions.h"
+#include "game/GameHistory.h"
+#include "game/Map.h"
+#include "game/Rule.h"
+
+/**
+ * @brief A batch of independent games played in lockstep by simulated agents.
+ *
+ * The batch plays the same games as `Game` and `Agent`, with agents sharing the same opening
+ * parameters and each using one of a set of rating strategies, but advances all the games of the
+ * batch together, turn after turn. The state of the games is stored as structure of arrays, the game
+ * being the fastest-varying index, so that the updates of the colors, the exploration probabilities,
+ * the replay decisions and the rating draws are loops over the games that the compiler can vectorize.
+ *
+ * The exploration probabilities only depend on the colors, so they are computed once per game and
+ * round for all the players, and the cells are drawn from their cumulative sums by binary search.
+ * The random draws are not made in the same order as with `Game` and `Agent`, so the games are not
+ * identical, but they follow the same distribution.
+ *
+ * @tparam Dimensions `DynamicDimensions`, or `FixedDimensions` for a specialized engine with constant loop
+ *         bounds and fixed-size storage. Only the dimensions instantiated in GameBatch.cpp are available;
+ *         drivers select one with `dispatchDimensions`.
+ */
+template <typename Dimensions>
+class BasicGameBatch
+{
+public:
+    /**
+     * @brief The best cells of each round of a player, indexed by round then by turn.
+     */
+    using BestCells = typename Dimensions::template RoundArray<typename Dimensions::template TurnArray<Cell>>;
+
+    /**
+     * @brief The scores of the players of a game, indexed by player.
+     */
+    using Scores = typename Dimensions::template PlayerArray<int>;
+
+    /**
+     * @brief Build a batch of games played on a shared map.
+     *
+     * @param batchSize Number of games of the batch.
+     * @param dimensions The numbers of rounds, turns, players and cells of the games.
+     * @param rule The scoring rule.
+     * @param map The map, shared with other games. Must not be null and have `dimensions.numberOfCells()` cells.
+     * @param tauEvaporation Evaporation time of the ratings, or NaN for no evaporation.
+     * @param parametersOpenings Parameters of the opening strategy of all the agents, in the layout of
+     *        `OpeningStrategy`: the exploration parameters then the two replay parameters of each turn.
+     * @param ratingStrategies The rating strategies the agents can be given, see `setRatingStrategy`.
+     */
+    BasicGameBatch(int batchSize, const Dimensions &dimensions, const Rule &rule, std::shared_ptr<const Map> map,
+                   double tauEvaporation, const std::vector<double> &parametersOpenings,
+                   const std::vector<RatingStrategy> &ratingStrategies);
+
+    /**
+     * @brief Build a batch of games with the rule 2, without evaporation, on the non-shuffled map.
+     */
+    BasicGameBatch(int batchSize, const Dimensions &dimensions, const std::vector<double> &parametersOpenings,
+                   const std::vector<RatingStrategy> &ratingStrategies);
+
+    /**
+     * @brief Restore all the games to their initial state so that the batch can be played again.
+     *
+     * The rating strategies of the players and the maps of the games are kept.
+     */
+    void reset();
+
+    /**
+     * @brief Play a game of the batch on another map, e.g. drawn from a `MapPool`.
+     *
+     * @param iGame The index of the game in the batch.
+     * @param map The map, with the same number of cells as the map of the batch, and no value above its
+     *        highest value, for which the rating strategies are tabulated.
+     * @throws std::invalid_argument If the map does not match the map of the batch.
+     */
+    void setMap(int iGame, std::shared_ptr<const Map> map);
+
+    /**
+     * @brief Give a rating strategy to a player of a game.
+     *
+     * @param iGame The index of the game in the batch.
+     * @param iPlayer The index of the player.
+     * @param iStrategy The index of the strategy in the rating strategies of the batch.
+     */
+    void setRatingStrategy(int iGame, int iPlayer, int iStrategy);
+
+    /**
+     * @brief Play all the rounds of all the games of the batch.
+     *
+     * The batch must have been reset beforehand.
+     */
+    void play();
+
+    [[nodiscard]] int getBatchSize() const;
+
+    [[nodiscard]] const Dimensions &getDimensions() const;
+
+    [[nodiscard]] int getNumberOfRounds() const;
+
+    [[nodiscard]] int getNumberOfTurns() const;
+
+    [[nodiscard]] int getNumberOfPlayers() const;
+
+    [[nodiscard]] int getNumberOfCells() const;
+
+    /**
+     * @brief Get the map of a game.
+     *
+     * @param iGame The index of the game in the batch.
+     * @return A reference to the map the game is played on.
+     */
+    [[nodiscard]] const Map &getMap(int iGame) const;
+
+    /**
+     * @brief Get the record of all the cells opened and rated in a game.
+     *
+     * @param iGame The index of the game in the batch.
+     * @return A reference to the history of the game.
+     */
+    [[nodiscard]] const GameHistory &getHistory(int iGame) const;
+
+    /**
+     * @brief Get the scores of all the players of a game, indexed by player.
+     *
+     * @param iGame The index of the game in the batch.
+     */
+    [[nodiscard]] const Scores &getScores(int iGame) const;
+
+    /**
+     * @brief Get the best cells of each round of a player, sorted by decreasing value.
+     *
+     * @param iGame The index of the game in the batch.
+     * @param iPlayer The index of the player.
+     * @return A reference to the best cells, indexed by round then by turn.
+     */
+    [[nodiscard]] const BestCells &getBestCells(int iGame, int iPlayer) const;
+
+private:
+    /**
+     * @brief Play all the rounds of all the games of the batch with the scoring policy of the rule.
+     *
+     * @tparam RulePolicy The scoring policy matching `m_rule`, see `visitRule`.
+     */
+    template <typename RulePolicy>
+    void playWithRule();
+
+    /**
+     * @brief Compute the cumulative exploration weights of every game from the colors.
+     */
+    void updateExploringWeights();
+
+    /**
+     * @brief Make every player of every game play a turn, and accumulate the score of the turn.
+     *
+     * @param iPlayer The index of the player.
+     * @param iTurn The index of the turn.
+     */
+    template <typename RulePolicy>
+    void playATurn(int iPlayer, int iTurn);
+
+    /**
+     * @brief Draw a cell to explore for a player of a game.
+     *
+     * The cells already opened during the round and the best cells of the previous round are excluded.
+     *
+     * @param iGame The index of the game in the batch.
+     * @param iPlayer The index of the player.
+     * @param iTurn The index of the turn.
+     * @return The index of the cell.
+     */
+    int chooseACellByExploring(int iGame, int iPlayer, int iTurn);
+
+    /**
+     * @brief Get the exploration weight of a cell in a game.
+     */
+    double getExploringWeight(int iCell, int iGame) const;
+
+    /**
+     * @brief Update the best cells, the colors and the scores of every game, and advance to the next round.
+     */
+    template <typename RulePolicy>
+    void changeRound();
+
+    /**
+     * @brief Sort the cells opened by a player during the round into its best cells of the round.
+     *
+     * @param iGame The index of the game in the batch.
+     * @param iPlayer The index of the player.
+     */
+    void updateBestCells(int iGame, int iPlayer);
+
+    /**
+     * @brief Add the stars given during the round to the star maps and their running sums.
+     */
+    void updateColors();
+
+    /**
+     * @brief Fold the evaporation scale factor into the star maps, to keep the stored stars from overflowing.
+     */
+    void rescaleStars();
+
+    /**
+     * @brief Check that the rating strategies can be drawn from their tables for every value of the map.
+     *
+     * @param ratingStrategies The rating strategies of the batch.
+     * @throws std::invalid_argument If there is no strategy, if the strategies do not give the same ratings, or
+     *         if the map has values above those tabulated by the strategies.
+     */
+    void checkRatingStrategies(const std::vector<RatingStrategy> &ratingStrategies) const;
+
+    // Below this evaporation scale, the star maps are rescaled, as in `Game`
+    static constexpr double minEvaporationScale{1e-200};
+
+    // Constant variables
+    const int m_batchSize;
+    const Dimensions m_dimensions;
+    const Rule m_rule;
+    const std::shared_ptr<const Map> mp_map;
+    const double m_tauEvaporation;
+    // Opening strategy shared by all the agents
+    double m_exploration;
+    double m_exponent;
+    typename Dimensions::template TurnArray<double> m_replayOffsets;
+    typename Dimensions::template TurnArray<double> m_replaySlopes;
+    // Rating strategies, drawn from their own tables, and the index of the strategy of each [game][player]
+    std::vector<RatingStrategy> m_ratingStrategies;
+    std::vector<int> m_ratings;
+    int m_numberOfRatings;
+    std::vector<int> m_strategies;
+    // Map of each game, the map of the batch unless set otherwise
+    std::vector<std::shared_ptr<const Map>> m_maps;
+    // Variables updated at each round, stored as [cell][game]
+    int m_iRound;
+    std::vector<double> m_stars;
+    std::vector<double> m_sumOfStars;
+    double m_evaporationScale;
+    std::vector<double> m_exploringCumulatives;
+    std::vector<double> m_sumOfPowers;
+    std::vector<double> m_uniformWeights;
+    // Per-game records
+    std::vector<GameHistory> m_histories;
+    std::vector<Scores> m_scores;
+    std::vector<BestCells> m_bestCells;
+    // Scores and stars remaining of the current round, stored as [game][player]
+    std::vector<int> m_roundScores;
+    std::vector<int> m_numberOfRatingsRemaining;
+    // Buffers of the turns, stored as [game]
+    std::vector<double> m_uniforms;
+    std::vector<const double *> m_ratingCumulatives;
+    std::vector<double> m_replayValues;
+    std::vector<int> m_replays;
+    std::vector<int> m_values;
+    std::vector<int> m_iRatings;
+    // Cells excluded from the exploration of a turn: the previous best cells and the cells already played
+    typename Dimensions::template TurnArray<int, 2> m_excludedCells;
+};
+
+/**
+ * @brief A batch of games whose dimensions are only known at run time.
+ */
+using GameBatch = BasicGameBatch<DynamicDimensions>;
+
+extern template class BasicGameBatch<DynamicDimensions>;
+extern template class BasicGameBatch<ExperimentDimensions>;
+
+#endif
@@ -0,0 +1,88 @@
+#include <stdexcept> // std::invalid_argument
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "agent/Agent.h"
+#include "agent/ExplorationCache.h"
+#include "agent/OpeningStrategy.h"
+#include "agent/RatingStrategy.h"
+#include "game/Dimensions.h"
+#include "game/Game.h"
+#include "game_batch/GameBatch.h"
+#include "helpers/PlayerProfiles.h"
+#include "helpers/helper_all.h"
+#include "random/CumulativeSampler.h"
+
+PlayerProfiles::PlayerProfiles(const std::vector<double> &parametersOpenings,
+                               const std::vector<RatingStrategy> &ratingStrategies,
+                               const std::vector<double> &fractions)
+    : m_ratingStrategies{ratingStrategies},
+      m_prototypes{},
+      m_profileSampler{fractions}
+{
+    if (fractions.size() != ratingStrategies.size())
+    {
+        throw std::invalid_argument("PlayerProfiles: There must be one fraction per rating strategy.");
+    }
+
+    // The opening strategy is built once, and shared by the prototypes
+    const OpeningStrategy openingStrategy(parametersOpenings);
+    m_prototypes.reserve(m_ratingStrategies.size());
+    for (const auto &ratingStrategy : m_ratingStrategies)
+    {
+        m_prototypes.emplace_back(openingStrategy, ratingStrategy);
+    }
+}
+
+PlayerProfiles::PlayerProfiles(const std::vector<double> &parametersOpenings,
+                               const nlohmann::json &parametersStars,
+                               const std::vector<double> &fractions)
+    : PlayerProfiles(parametersOpenings, initializeRatingStrategies(parametersStars), fractions)
+{
+}
+
+int PlayerProfiles::drawProfile() const
+{
+    return static_cast<int>(m_profileSampler.draw());
+}
+
+const std::vector<RatingStrategy> &PlayerProfiles::getRatingStrategies() const
+{
+    return m_ratingStrategies;
+}
+
+std::vector<Agent> PlayerProfiles::makePlayers(int numberOfAgents, Game &game) const
+{
+    std::vector<Agent> agents;
+    agents.reserve(numberOfAgents);
+    for (int iAgent{0}; iAgent < numberOfAgents; ++iAgent)
+    {
+        agents.push_back(m_prototypes[drawProfile()]);
+        agents.back().assignToGame(game.getAddress());
+    }
+    return agents;
+}
+
+void PlayerProfiles::reassignPlayers(std::vector<Agent> &agents, Game &game, ExplorationCache *explorationCache) const
+{
+    for (auto &agent : agents)
+    {
+        agent.assignToGame(game.getAddress(), m_ratingStrategies[drawProfile()], explorationCache);
+    }
+}
+
+template <typename Dimensions>
+void PlayerProfiles::reassignPlayers(BasicGameBatch<Dimensions> &batch) const
+{
+    for (int iGame{0}; iGame < batch.getBatchSize(); ++iGame)
+    {
+        for (int iPlayer{0}; iPlayer < batch.getNumberOfPlayers(); ++iPlayer)
+        {
+            batch.setRatingStrategy(iGame, iPlayer, drawProfile());
+        }
+    }
+}
+
+template void PlayerProfiles::reassignPlayers(BasicGameBatch<DynamicDimensions> &) const;
+template void PlayerProfiles::reassignPlayers(BasicGameBatch<ExperimentDimensions> &) const;
@@ -0,0 +1,97 @@
+#ifndef PLAYER_PROFILES_H
+#define PLAYER_PROFILES_H
+
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "agent/Agent.h"
+#include "agent/ExplorationCache.h"
+#include "agent/RatingStrategy.h"
+#include "game/Game.h"
+#include "game_batch/GameBatch.h"
+#include "random/CumulativeSampler.h"
+
+/**
+ * @brief The profiles col/neu/def of the players of the simulated games, and the draw of the profile of each
+ * player.
+ *
+ * A prototype agent is built once per profile, from the parameters of the openings and the rating strategy of
+ * the profile, and the players of the games are copies of the prototypes, which share the immutable data of
+ * their strategies, see `RatingStrategy` and `OpeningStrategy`. The profiles are drawn from a sampler built
+ * once from the fractions of the profiles, which gives the same profiles as `myRandom::randIndexWeighted`.
+ * Setting up the players of a game thus reads no JSON and builds no strategy.
+ */
+class PlayerProfiles
+{
+public:
+    /**
+     * @brief Build the prototypes of the profiles.
+     *
+     * @param parametersOpenings Parameters of the opening strategy shared by all the profiles.
+     * @param ratingStrategies The rating strategy of each profile, in the order col/neu/def.
+     * @param fractions The non-negative sampling weights of the profiles, in the same order.
+     * @throws std::invalid_argument If there is not one fraction per rating strategy.
+     */
+    PlayerProfiles(const std::vector<double> &parametersOpenings,
+                   const std::vector<RatingStrategy> &ratingStrategies,
+                   const std::vector<double> &fractions);
+
+    /**
+     * @brief Build the prototypes of the profiles from the JSON entries of their rating strategies.
+     *
+     * @param parametersOpenings Parameters of the opening strategy shared by all the profiles.
+     * @param parametersStars JSON object containing one rating-strategy entry per profile.
+     * @param fractions The non-negative sampling weights of the profiles, in the order col/neu/def.
+     */
+    PlayerProfiles(const std::vector<double> &parametersOpenings,
+                   const nlohmann::json &parametersStars,
+                   const std::vector<double> &fractions);
+
+    /**
+     * @brief Draw the profile of a player.
+     *
+     * @return The index of the profile, in the order col/neu/def.
+     */
+    [[nodiscard]] int drawProfile() const;
+
+    /**
+     * @brief Get the rating strategy of each profile, in the order col/neu/def.
+     */
+    [[nodiscard]] const std::vector<RatingStrategy> &getRatingStrategies() const;
+
+    /**
+     * @brief Create the players of a game, of randomly drawn profiles, as copies of the prototypes.
+     *
+     * @param numberOfAgents Number of players to create.
+     * @param game The game the players are assigned to.
+     * @return The players.
+     */
+    [[nodiscard]] std::vector<Agent> makePlayers(int numberOfAgents, Game &game) const;
+
+    /**
+     * @brief Assign recycled players to a game, drawing a new profile for each of them.
+     *
+     * @param agents The players to reassign.
+     * @param game The game the players are assigned to. It must have been reset beforehand.
+     * @param explorationCache The cache of the exploration distributions shared by the players of the game, or
+     *        null for none, see `Agent::assignToGame`.
+     */
+    void reassignPlayers(std::vector<Agent> &agents, Game &game, ExplorationCache *explorationCache = nullptr) const;
+
+    /**
+     * @brief Draw a new profile for every player of every game of a batch.
+     *
+     * @param batch The batch of games, built with the rating strategies of `getRatingStrategies`.
+     */
+    template <typename Dimensions>
+    void reassignPlayers(BasicGameBatch<Dimensions> &batch) const;
+
+private:
+    std::vector<RatingStrategy> m_ratingStrategies;
+    // Agent of each profile, not assigned to any game
+    std::vector<Agent> m_prototypes;
+    myRandom::CumulativeSampler m_profileSampler;
+};
+
+#endif
@@ -1,3 +1,4 @@
+#include <algorithm> // std::min
 #include <fstream>   // std::ifstream
 #include <stdexcept> // std::runtime_error
 #include <string>
@@ -6,10 +7,21 @@
 #include <nlohmann/json.hpp>
 
 #include "agent/Agent.h"
+#include "agent/RatingStrategy.h"
+#include "game/Dimensions.h"
 #include "game/Game.h"
+#include "game/MapPool.h"
+#include "game_analyzer/GameAnalyzer.h"
+#include "game_batch/GameBatch.h"
+#include "helpers/PlayerProfiles.h"
 #include "helpers/helper_all.h"
 #include "random/myRandom.h"
 
+namespace
+{
+    const std::vector<std::string> profiles{"col", "neu", "def"};
+} // namespace
+
 std::vector<double> readParameters(const std::string &filePath)
 {
     std::ifstream file(filePath);
@@ -57,15 +69,64 @@ std::vector<Agent> initializePlayers(int numberOfAgents,
                                      const std::vector<double> &parametersVisits,
                                      const nlohmann::json &parametersStars)
 {
-    const std::vector<std::string> profiles{"col", "neu", "def"};
+    return PlayerProfiles(parametersVisits, parametersStars, fractions).makePlayers(numberOfAgents, game);
+}
 
-    std::vector<Agent> agents;
-    agents.reserve(numberOfAgents);
-    for (int iAgent{0}; iAgent < numberOfAgents; ++iAgent)
+std::vector<RatingStrategy> initializeRatingStrategies(const nlohmann::json &parametersStars)
+{
+    std::vector<RatingStrategy> ratingStrategies;
+    ratingStrategies.reserve(profiles.size());
+    for (const auto &profile : profiles)
     {
-        const std::string profile{myRandom::choice(profiles, fractions)};
-        agents.emplace_back(game.getAddress(), parametersVisits, parametersStars[profile]);
+        ratingStrategies.emplace_back(parametersStars[profile]);
     }
+    return ratingStrategies;
+}
+
+void simulateGames(GameAnalyzer &analyzer,
+                   int numberOfGames,
+                   const DynamicDimensions &dimensions,
+                   int batchSize,
+                   const std::vector<double> &parametersOpenings,
+                   const std::vector<RatingStrategy> &ratingStrategies,
+                   const std::vector<double> &fractions,
+                   const MapPool *maps)
+{
+    const int numberOfBatches{(numberOfGames + batchSize - 1) / batchSize};
+    dispatchDimensions(dimensions.numberOfRounds(), dimensions.numberOfTurns(), dimensions.numberOfPlayers(),
+                       dimensions.numberOfCells(),
+                       [&](const auto &dispatchedDimensions)
+                       {
+#pragma omp parallel
+                           {
+                               // Each thread keeps a single batch alive, and recycles it for all its repetitions
+                               BasicGameBatch batch(batchSize, dispatchedDimensions, parametersOpenings,
+                                                    ratingStrategies);
+                               const PlayerProfiles playerProfiles(parametersOpenings, ratingStrategies, fractions);
+
+#pragma omp for
+                               for (int iBatch = 0; iBatch < numberOfBatches; ++iBatch)
+                               {
+                                   const int iFirstGame{iBatch * batchSize};
+                                   const int iLastGame{std::min(iFirstGame + batchSize, numberOfGames)};
+
+                                   // Initialize the games and the agents
+                                   batch.reset();
+                                   playerProfiles.reassignPlayers(batch);
+                                   for (int iGame{iFirstGame}; maps && iGame < iFirstGame + batchSize; ++iGame)
+                                   {
+                                       batch.setMap(iGame - iFirstGame, maps->getMap(iGame));
+                                   }
+
+                                   // Play the games
+                                   batch.play();
 
-    return agents;
+                                   // Analyze the games, the last batch being only partially used
+                                   for (int iGame{iFirstGame}; iGame < iLastGame; ++iGame)
+                                   {
+                                       analyzer.analyzeGame(iGame, batch, iGame - iFirstGame);
+                                   }
+                               }
+                           }
+                       });
 }
@@ -7,7 +7,12 @@
 #include <nlohmann/json.hpp>
 
 #include "agent/Agent.h"
+#include "agent/RatingStrategy.h"
+#include "game/Dimensions.h"
 #include "game/Game.h"
+#include "game/MapPool.h"
+#include "game_analyzer/GameAnalyzer.h"
+#include "game_batch/GameBatch.h"
 
 /**
  * @brief Read space-separated numeric parameters from the last non-empty line of a file.
@@ -21,7 +26,8 @@ std::vector<double> readParameters(const std::string &filePath);
  * @brief Create a set of agents assigned to the given game with randomly drawn profiles.
  *
  * The profile of each agent is drawn from `{"col", "neu", "def"}` according to `fractions`, and its
- * rating strategy is taken from the JSON entry named after the drawn profile.
+ * rating strategy is taken from the JSON entry named after the drawn profile. The strategies are built once
+ * per call; a `PlayerProfiles` kept across the games avoids even that.
  *
  * @param numberOfAgents Number of agents to create.
  * @param fractions Sampling weights for the three profiles, in the order col/neu/def.
@@ -36,4 +42,38 @@ std::vector<Agent> initializePlayers(int numberOfAgents,
                                      const std::vector<double> &parametersVisits,
                                      const nlohmann::json &parametersStars);
 
+/**
+ * @brief Build the rating strategy of each profile, in the order col/neu/def.
+ *
+ * @param parametersStars JSON object containing one rating-strategy entry per profile.
+ * @return The rating strategies of the three profiles.
+ */
+std::vector<RatingStrategy> initializeRatingStrategies(const nlohmann::json &parametersStars);
+
+/**
+ * @brief Simulate games with agents of randomly drawn profiles, and analyze them.
+ *
+ * The games are played by batches of games in lockstep, in parallel over the OpenMP threads. The batches
+ * use the engine specialized for the dimensions of the games if there is one, see `dispatchDimensions`.
+ *
+ * @param analyzer The analyzer of the games. It must have been initialized for `numberOfGames` games of
+ *        the given dimensions.
+ * @param numberOfGames Number of games to simulate.
+ * @param dimensions The numbers of rounds, turns, players and cells of the games.
+ * @param batchSize Number of games of each batch.
+ * @param parametersOpenings Parameters of the opening strategy shared by all agents.
+ * @param ratingStrategies The rating strategy of each profile, as returned by `initializeRatingStrategies`.
+ * @param fractions Sampling weights for the three profiles, in the order col/neu/def.
+ * @param maps If not null, the game `iGame` is played on the map `maps->getMap(iGame)` instead of the
+ *        non-shuffled map, to check that the agents do not rely on the positions of the best cells.
+ */
+void simulateGames(GameAnalyzer &analyzer,
+                   int numberOfGames,
+                   const DynamicDimensions &dimensions,
+                   int batchSize,
+                   const std::vector<double> &parametersOpenings,
+                   const std::vector<RatingStrategy> &ratingStrategies,
+                   const std::vector<double> &fractions,
+                   const MapPool *maps = nullptr);
+
 #endif
@@ -10,10 +10,10 @@
 
 #include <nlohmann/json.hpp> // nlohmann::json, nlohmann::json::parse
 
-#include "agent/Agent.h"                // Agent
-#include "game/Game.h"                  // Game
+#include "agent/RatingStrategy.h"       // RatingStrategy
+#include "game/Dimensions.h"            // DynamicDimensions
 #include "game_analyzer/GameAnalyzer.h" // GameAnalyzer
-#include "helpers/helper_all.h"         // readParameters, initializePlayers
+#include "helpers/helper_all.h"         // readParameters, initializeRatingStrategies, simulateGames
 #include "random/myRandom.h"            // myRandom::rand, myRandom::randIndex
 
 std::vector<double> readValuesObservable(const std::string &filePath)
@@ -117,32 +117,19 @@ double getAverageError(
     const int numberOfPlayers,
     const std::vector<double> &parametersOpenings,
     const nlohmann::json &parametersRatings,
-    const nlohmann::json &fractionPlayersProfiles,
+    const std::vector<double> &fractionPlayersProfiles,
     const std::string &pathObservables)
 {
-    GameAnalyzer analyzer(numberOfGames, numberOfPlayers);
-    {
-        Game sampleGame(numberOfRounds, numberOfPlayers);
-        analyzer.initialize(sampleGame.getNumberOfRounds(), sampleGame.getNumberOfTurns(), sampleGame.getNumberOfCells());
-    }
-
-#pragma omp parallel for
-    for (int iGame = 0; iGame < numberOfGames; ++iGame)
-    {
-        Game game(numberOfRounds, numberOfPlayers);
-
-        std::vector<Agent> agents{initializePlayers(numberOfPlayers, fractionPlayersProfiles, game, parametersOpenings, parametersRatings)};
+    // The games have the 3 turns and 225 cells of the experiment, and are played by batches of games in lockstep
+    const DynamicDimensions dimensions(numberOfRounds, 3, numberOfPlayers, 225);
+    const int batchSize{16};
 
-        for (int iRound{0}; iRound < numberOfRounds; ++iRound)
-        {
-            for (auto &agent : agents)
-            {
-                agent.playARound();
-            }
-        }
+    GameAnalyzer analyzer(numberOfGames, numberOfPlayers);
+    analyzer.initialize(dimensions.numberOfRounds(), dimensions.numberOfTurns(), dimensions.numberOfCells());
 
-        analyzer.analyzeGame(iGame, game, agents);
-    }
+    const std::vector<RatingStrategy> ratingStrategies{initializeRatingStrategies(parametersRatings)};
+    simulateGames(analyzer, numberOfGames, dimensions, batchSize, parametersOpenings, ratingStrategies,
+                  fractionPlayersProfiles);
 
     return computeTotalError(pathObservables, analyzer);
 }
@@ -200,7 +187,7 @@ void doMonteCarloStep(
     const int numberOfRounds,
     const int numberOfPlayers,
     const nlohmann::json &parametersRatings,
-    const nlohmann::json &fractionPlayersProfiles,
+    const std::vector<double> &fractionPlayersProfiles,
     const std::string &pathObservables,
     const std::string &pathParameters)
 {
@@ -249,7 +236,7 @@ int main()
 
     // Read the parameters of the agents
     const std::vector<double> fractionPlayersProfiles{readParameters(pathParameters + "players_profiles.txt")};
-    const nlohmann::json parametersRatings{nlohmann::json::parse(std::ifstream(pathParameters + "stars.json"))};
+    const nlohmann::json parametersRatings(nlohmann::json::parse(std::ifstream(pathParameters + "stars.json")));
 
     // Initialization of the MC simulation
     std::vector<double> bestParametersOpenings{readParameters(pathParameters + "cells.txt")};
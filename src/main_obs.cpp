@@ -5,15 +5,17 @@
  */
 
 #include <fstream> // std::ifstream
+#include <memory>  // std::make_unique, std::unique_ptr
 #include <string>  // std::string
 #include <vector>  // std::vector
 
 #include <nlohmann/json.hpp> // nlohmann::json, nlohmann::json::parse
 
-#include "agent/Agent.h"                // Agent
-#include "game/Game.h"                  // Game
+#include "agent/RatingStrategy.h"       // RatingStrategy
+#include "game/Dimensions.h"            // DynamicDimensions
+#include "game/MapPool.h"               // MapPool
 #include "game_analyzer/GameAnalyzer.h" // GameAnalyzer
-#include "helpers/helper_all.h"         // readParameters, initializePlayers
+#include "helpers/helper_all.h"         // readParameters, initializeRatingStrategies, simulateGames
 #include "random/myRandom.h"            // myRandom::seed
 
 int main()
@@ -28,7 +30,12 @@ int main()
     // Parameters of the simulation
     const int numberOfGames{100000};
     const int numberOfRounds{20};
+    const int numberOfTurns{3};
     const int numberOfPlayers{5};
+    const int numberOfCells{225};
+    const int batchSize{16};
+    // Number of shuffled maps the games are played on (0 to play all the games on the non-shuffled map)
+    const int numberOfMaps{0};
 
     const std::string pathData{"./data/example/"};
 
@@ -36,37 +43,19 @@ int main()
     const std::string pathParameters{pathData + "model/parameters/"};
     const std::vector<double> fractionPlayersProfiles{readParameters(pathParameters + "players_profiles.txt")};
     const std::vector<double> parametersOpenings{readParameters(pathParameters + "cells.txt")};
-    const nlohmann::json parametersRatings{nlohmann::json::parse(std::ifstream(pathParameters + "stars.json"))};
+    const nlohmann::json parametersRatings(nlohmann::json::parse(std::ifstream(pathParameters + "stars.json")));
 
     // Initialize the analyzer
     GameAnalyzer analyzer(numberOfGames, numberOfPlayers);
-    {
-        Game sampleGame(numberOfRounds, numberOfPlayers);
-        analyzer.initialize(sampleGame.getNumberOfRounds(), sampleGame.getNumberOfTurns(), sampleGame.getNumberOfCells());
-    }
-
-    // Loop over all repetitions of the game
-#pragma omp parallel for
-    for (int iGame = 0; iGame < numberOfGames; ++iGame)
-    {
-        // Initialize the game
-        Game game(numberOfRounds, numberOfPlayers);
+    analyzer.initialize(numberOfRounds, numberOfTurns, numberOfCells);
 
-        // Initialize the agents
-        std::vector<Agent> agents{initializePlayers(numberOfPlayers, fractionPlayersProfiles, game, parametersOpenings, parametersRatings)};
-
-        // Play the game
-        for (int iRound{0}; iRound < numberOfRounds; ++iRound)
-        {
-            for (auto &agent : agents)
-            {
-                agent.playARound();
-            }
-        }
-
-        // Analyze the game
-        analyzer.analyzeGame(iGame, game, agents);
-    }
+    // Play and analyze all repetitions of the game, by batches of games in lockstep
+    const std::vector<RatingStrategy> ratingStrategies{initializeRatingStrategies(parametersRatings)};
+    const DynamicDimensions dimensions(numberOfRounds, numberOfTurns, numberOfPlayers, numberOfCells);
+    const std::unique_ptr<const MapPool> maps{
+        numberOfMaps > 0 ? std::make_unique<const MapPool>(numberOfCells, numberOfMaps, seed) : nullptr};
+    simulateGames(analyzer, numberOfGames, dimensions, batchSize, parametersOpenings, ratingStrategies,
+                  fractionPlayersProfiles, maps.get());
 
     // Average the observables over all repetition and save them
     analyzer.saveObservables(pathData + "model/observables/");
@@ -0,0 +1,55 @@
+#include <iterator>  // std::next
+#include <map>       // std::map
+#include <memory>    // std::make_shared, std::shared_ptr, std::weak_ptr
+#include <mutex>     // std::lock_guard, std::mutex
+#include <numeric>   // std::iota
+#include <stdexcept> // std::invalid_argument
+#include <utility>   // std::pair
+#include <vector>
+
+#include "math/PowerTable.h"
+#include "math/VectorMath.h"
+
+myMath::PowerTable::PowerTable(double exponent, int maxTabulatedBase)
+    : m_exponent{exponent},
+      m_powers{}
+{
+    if (maxTabulatedBase < 0)
+    {
+        throw std::invalid_argument("The largest tabulated base must be non-negative.");
+    }
+    m_powers.resize(maxTabulatedBase + 1);
+    std::iota(m_powers.begin(), m_powers.end(), 0.);
+    myMath::pow(m_powers.data(), m_exponent, m_powers.data(), m_powers.size());
+}
+
+std::shared_ptr<const myMath::PowerTable> myMath::PowerTable::getShared(double exponent, int maxTabulatedBase)
+{
+    static std::mutex mutex;
+    // The tables are not kept once unused, as an optimization of the parameters may go through many exponents
+    static std::map<std::pair<double, int>, std::weak_ptr<const PowerTable>> tables;
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    std::weak_ptr<const PowerTable> &weakTable{tables[{exponent, maxTabulatedBase}]};
+    std::shared_ptr<const PowerTable> table{weakTable.lock()};
+    if (!table)
+    {
+        table = std::make_shared<const PowerTable>(exponent, maxTabulatedBase);
+        weakTable = table;
+        for (auto it{tables.begin()}; it != tables.end();)
+        {
+            it = it->second.expired() ? tables.erase(it) : std::next(it);
+        }
+    }
+    return table;
+}
+
+double myMath::PowerTable::getExponent() const
+{
+    return m_exponent;
+}
+
+int myMath::PowerTable::getMaxTabulatedBase() const
+{
+    return static_cast<int>(m_powers.size()) - 1;
+}
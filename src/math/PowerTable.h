@@ -0,0 +1,61 @@
+#ifndef POWER_TABLE_H
+#define POWER_TABLE_H
+
+#include <memory>
+#include <vector>
+
+#include "math/VectorMath.h"
+
+namespace myMath
+{
+    /**
+     * @brief Powers of the integers from 0 to a bound, for a fixed exponent.
+     *
+     * The powers are computed once at construction, with `myMath::pow`, so that a power is then read from the
+     * table instead of being computed. The powers of the integers beyond the bound are still computed on
+     * access, with the same function, so that the table only changes the cost of a power and not its value.
+     * A table is immutable once built, and can be shared by all the agents and threads using the exponent,
+     * see `PowerTable::getShared`.
+     */
+    class PowerTable
+    {
+    public:
+        /**
+         * @brief Build the table of the powers.
+         *
+         * @param exponent The exponent of the powers, 0 or of absolute value above 1e-305.
+         * @param maxTabulatedBase The largest integer whose power is stored. Must be non-negative.
+         */
+        PowerTable(double exponent, int maxTabulatedBase);
+
+        /**
+         * @brief Get a table of the powers, shared with all the other callers asking for the same table.
+         *
+         * The table is built on the first call, from any thread, and is kept as long as a caller holds it.
+         *
+         * @param exponent The exponent of the powers.
+         * @param maxTabulatedBase The largest integer whose power is stored.
+         * @return A shared pointer to the table.
+         */
+        static std::shared_ptr<const PowerTable> getShared(double exponent, int maxTabulatedBase);
+
+        [[nodiscard]] double getExponent() const;
+
+        [[nodiscard]] int getMaxTabulatedBase() const;
+
+        /**
+         * @brief Get the power of a non-negative integer.
+         */
+        [[nodiscard]] double operator()(int base) const
+        {
+            return base < static_cast<int>(m_powers.size()) ? m_powers[base]
+                                                            : myMath::pow(static_cast<double>(base), m_exponent);
+        }
+
+    private:
+        const double m_exponent;
+        std::vector<double> m_powers;
+    };
+}
+
+#endif
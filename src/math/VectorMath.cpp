@@ -0,0 +1,38 @@
+#include <cstddef> // std::size_t
+
+#include "math/VectorMath.h"
+
+// The build targets the baseline instruction set, so the array functions are also compiled for the wider
+// vectors of recent x86 processors, the version matching the processor being chosen when the program is loaded
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_MATH_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define VECTOR_MATH_CLONES
+#endif
+
+VECTOR_MATH_CLONES void myMath::exp(const double *x, double *result, std::size_t n)
+{
+#pragma omp simd
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        result[i] = myMath::exp(x[i]);
+    }
+}
+
+VECTOR_MATH_CLONES void myMath::pow(const double *x, double exponent, double *result, std::size_t n)
+{
+#pragma omp simd
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        result[i] = myMath::pow(x[i], exponent);
+    }
+}
+
+VECTOR_MATH_CLONES void myMath::tanh(const double *x, double *result, std::size_t n)
+{
+#pragma omp simd
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        result[i] = myMath::tanh(x[i]);
+    }
+}
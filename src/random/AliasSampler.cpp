@@ -0,0 +1,92 @@
+#include <cstddef> // std::size_t
+#include <vector>
+
+#include "random/AliasSampler.h"
+#include "random/myRandom.h"
+
+myRandom::AliasSampler::AliasSampler(const std::vector<double> &weights)
+{
+    assign(weights);
+}
+
+void myRandom::AliasSampler::assign(const std::vector<double> &weights)
+{
+    const std::size_t n{weights.size()};
+    double sum{0.};
+    for (const double weight : weights)
+    {
+        sum += weight;
+    }
+
+    // The columns are scaled so that their mean height is 1
+    m_probabilities.resize(n);
+    m_aliases.resize(n);
+    m_smallColumns.clear();
+    m_largeColumns.clear();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        m_probabilities[i] = weights[i] * static_cast<double>(n) / sum;
+        m_aliases[i] = i;
+        if (m_probabilities[i] >= 1.)
+        {
+            m_largeColumns.push_back(i);
+        }
+        else if (m_probabilities[i] > 0.)
+        {
+            m_smallColumns.push_back(i);
+        }
+    }
+    // The empty columns are filled first, so that rounding errors never leave one of them without an alias
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (m_probabilities[i] == 0.)
+        {
+            m_smallColumns.push_back(i);
+        }
+    }
+
+    // Each small column is topped up by a large one, which may become small in turn
+    std::size_t iLastLarge{0};
+    while (!m_smallColumns.empty() && !m_largeColumns.empty())
+    {
+        const std::size_t iSmall{m_smallColumns.back()};
+        const std::size_t iLarge{m_largeColumns.back()};
+        m_smallColumns.pop_back();
+        m_aliases[iSmall] = iLarge;
+        iLastLarge = iLarge;
+        m_probabilities[iLarge] -= 1. - m_probabilities[iSmall];
+        if (m_probabilities[iLarge] < 1.)
+        {
+            m_largeColumns.pop_back();
+            m_smallColumns.push_back(iLarge);
+        }
+    }
+
+    // The columns left are full up to rounding errors
+    for (const std::size_t i : m_largeColumns)
+    {
+        m_probabilities[i] = 1.;
+    }
+    for (const std::size_t i : m_smallColumns)
+    {
+        m_probabilities[i] = weights[i] > 0. ? 1. : 0.;
+        m_aliases[i] = weights[i] > 0. ? i : iLastLarge;
+    }
+}
+
+std::size_t myRandom::AliasSampler::size() const
+{
+    return m_probabilities.size();
+}
+
+std::size_t myRandom::AliasSampler::draw() const
+{
+    // The integer part of the number chooses the column, and its fractional part the index within the column
+    const double u{myRandom::rand() * static_cast<double>(m_probabilities.size())};
+    std::size_t i{static_cast<std::size_t>(u)};
+    if (i >= m_probabilities.size())
+    {
+        i = m_probabilities.size() - 1;
+    }
+    return u - static_cast<double>(i) < m_probabilities[i] ? i : m_aliases[i];
+}
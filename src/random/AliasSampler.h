@@ -0,0 +1,61 @@
+#ifndef ALIAS_SAMPLER_H
+#define ALIAS_SAMPLER_H
+
+#include <cstddef>
+#include <vector>
+
+namespace myRandom
+{
+    /**
+     * @brief Draws indices with probabilities proportional to a set of weights, from an alias table.
+     *
+     * The table of Walker, built with the method of Vose, splits the weights into as many columns of equal
+     * height as there are indices, each column holding part of the weight of its own index and the rest of
+     * the weight of a single other index, its alias. The table is built once in O(n), after which each draw
+     * takes a single number from `myRandom::rand` and costs O(1) whatever the number of indices.
+     *
+     * The draws follow the same distribution as those of `CumulativeSampler` and `randIndexWeighted`, but
+     * not the same sequence of indices. The cumulative table is as fast for a few indices, and keeps the
+     * sequence of indices of `randIndexWeighted`, while the alias table is faster for large distributions
+     * that are reused for many draws, see `benchmarkSamplers` in bench/RandomBench.cpp.
+     */
+    class AliasSampler
+    {
+    public:
+        AliasSampler() = default;
+
+        /**
+         * @brief Build the table of the given weights.
+         *
+         * @param weights The non-negative weights of the indices, not all 0.
+         */
+        explicit AliasSampler(const std::vector<double> &weights);
+
+        /**
+         * @brief Rebuild the table for other weights, reusing its storage.
+         *
+         * @param weights The non-negative weights of the indices, not all 0.
+         */
+        void assign(const std::vector<double> &weights);
+
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * @brief Draw an index.
+         *
+         * @return An index drawn according to the weights.
+         */
+        [[nodiscard]] std::size_t draw() const;
+
+    private:
+        // Part of the column of each index that is kept by the index, in [0, 1]
+        std::vector<double> m_probabilities;
+        // Index that takes the rest of the column of each index
+        std::vector<std::size_t> m_aliases;
+        // Indices whose column is below and above the mean height, used during the construction only
+        std::vector<std::size_t> m_smallColumns;
+        std::vector<std::size_t> m_largeColumns;
+    };
+}
+
+#endif
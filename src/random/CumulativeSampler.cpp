@@ -0,0 +1,86 @@
+#include <algorithm> // std::binary_search, std::lower_bound, std::min
+#include <cstddef>   // std::size_t
+#include <vector>
+
+#include "random/CumulativeSampler.h"
+#include "random/myRandom.h"
+
+myRandom::CumulativeSampler::CumulativeSampler(const std::vector<double> &weights)
+{
+    assign(weights);
+}
+
+void myRandom::CumulativeSampler::assign(const std::vector<double> &weights)
+{
+    m_weights = weights;
+    m_cumulatives.resize(weights.size());
+    double sum{0.};
+    for (std::size_t i = 0; i < weights.size(); ++i)
+    {
+        sum += weights[i];
+        m_cumulatives[i] = sum;
+    }
+}
+
+std::size_t myRandom::CumulativeSampler::size() const
+{
+    return m_weights.size();
+}
+
+double myRandom::CumulativeSampler::getTotalWeight() const
+{
+    return m_cumulatives.empty() ? 0. : m_cumulatives.back();
+}
+
+std::size_t myRandom::CumulativeSampler::draw() const
+{
+    return draw({});
+}
+
+std::size_t myRandom::CumulativeSampler::draw(const std::vector<int> &excludedIndices) const
+{
+    double allowedTotal{getTotalWeight()};
+    for (const int iExcluded : excludedIndices)
+    {
+        allowedTotal -= m_weights[iExcluded];
+    }
+    double target{myRandom::rand() * allowedTotal};
+
+    // The draw among the allowed indices is mapped to the cumulative weights of all the indices by adding the
+    // weights of the excluded indices that come before it
+    for (const int iExcluded : excludedIndices)
+    {
+        if (target <= (iExcluded == 0 ? 0. : m_cumulatives[iExcluded - 1]))
+        {
+            break;
+        }
+        target += m_weights[iExcluded];
+    }
+    const std::size_t iChosen{std::min(
+        static_cast<std::size_t>(std::lower_bound(m_cumulatives.begin(), m_cumulatives.end(), target) -
+                                 m_cumulatives.begin()),
+        m_cumulatives.size() - 1)};
+
+    // Rounding errors may land the draw on an excluded index or on an index of weight 0, in which case the
+    // nearest allowed one is taken
+    auto isAllowed = [this, &excludedIndices](std::size_t i)
+    {
+        return m_weights[i] > 0. &&
+               !std::binary_search(excludedIndices.begin(), excludedIndices.end(), static_cast<int>(i));
+    };
+    for (std::size_t i = iChosen; i < m_weights.size(); ++i)
+    {
+        if (isAllowed(i))
+        {
+            return i;
+        }
+    }
+    for (std::size_t i = iChosen; i-- > 0;)
+    {
+        if (isAllowed(i))
+        {
+            return i;
+        }
+    }
+    return iChosen;
+}
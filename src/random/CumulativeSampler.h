@@ -0,0 +1,64 @@
+#ifndef CUMULATIVE_SAMPLER_H
+#define CUMULATIVE_SAMPLER_H
+
+#include <cstddef>
+#include <vector>
+
+namespace myRandom
+{
+    /**
+     * @brief Draws indices with probabilities proportional to a set of weights, from their cumulative sums.
+     *
+     * The table is built once in O(n), after which each draw is a binary search in O(log n). A draw may
+     * exclude a few indices, whose weights are skipped on the fly instead of being set to 0 in a copy of the
+     * weights, in O(k) for k excluded indices. Each draw takes a single number from `myRandom::rand`, and
+     * gives the same index as `randIndexWeighted` called on the weights with the excluded ones set to 0, up
+     * to rounding errors.
+     */
+    class CumulativeSampler
+    {
+    public:
+        CumulativeSampler() = default;
+
+        /**
+         * @brief Build the table of the given weights.
+         *
+         * @param weights The non-negative weights of the indices, not all 0.
+         */
+        explicit CumulativeSampler(const std::vector<double> &weights);
+
+        /**
+         * @brief Rebuild the table for other weights, reusing its storage.
+         *
+         * @param weights The non-negative weights of the indices, not all 0.
+         */
+        void assign(const std::vector<double> &weights);
+
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] double getTotalWeight() const;
+
+        /**
+         * @brief Draw an index.
+         *
+         * @return An index drawn according to the weights.
+         */
+        [[nodiscard]] std::size_t draw() const;
+
+        /**
+         * @brief Draw an index among those that are not excluded.
+         *
+         * @param excludedIndices The excluded indices, sorted by increasing index and without duplicates. At
+         *        least one index of positive weight must remain.
+         * @return An index drawn according to the weights of the indices that are not excluded.
+         */
+        [[nodiscard]] std::size_t draw(const std::vector<int> &excludedIndices) const;
+
+    private:
+        std::vector<double> m_weights;
+        // Sum of the weights of the indices 0 to i
+        std::vector<double> m_cumulatives;
+    };
+}
+
+#endif
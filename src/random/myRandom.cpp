@@ -62,5 +62,28 @@ std::size_t myRandom::randIndex(std::size_t high)
 
 std::size_t myRandom::randIndexWeighted(const std::vector<double> &weights)
 {
-    return std::discrete_distribution<std::size_t>(weights.begin(), weights.end())(myRandom::detail::engine);
+    // For non-negative weights, same draw as `std::discrete_distribution`, up to rounding errors, without building
+    // its tables. The weights that are not positive are skipped by the scan, whereas `std::discrete_distribution`
+    // subtracts a negative weight from the running sums of the later indices
+    double sum{0.};
+    for (const double weight : weights)
+    {
+        sum += weight;
+    }
+    const double target{rand() * sum};
+    double cumulative{0.};
+    std::size_t iLast{0};
+    for (std::size_t i = 0; i < weights.size(); ++i)
+    {
+        if (weights[i] > 0.)
+        {
+            cumulative += weights[i];
+            iLast = i;
+            if (cumulative >= target)
+            {
+                return i;
+            }
+        }
+    }
+    return iLast;
 }
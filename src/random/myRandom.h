@@ -94,6 +94,13 @@ namespace myRandom
     /**
      * @brief Generate a random index using a weighted probability distribution.
      *
+     * The weights are scanned at each call, without allocating. To draw many times from the same weights,
+     * build a `CumulativeSampler` or an `AliasSampler` once instead.
+     *
+     * The index is drawn from a uniform number times the sum of all the weights, compared with the running
+     * sums of the positive weights only, so that an index whose weight is not positive is never drawn, as in
+     * `RatingStrategy`.
+     *
      * @param weights Vector of weights.
      * @return A random index drawn according to the given weights.
      */